@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_ATTRIBUTEFILTER_H
+#define UP_TRANSPORT_ZENOH_CPP_ATTRIBUTEFILTER_H
+
+#include <up-core-api/uattributes.pb.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ScannedAttributes.h"
+
+namespace uprotocol::transport {
+
+/// @brief Conditions on the attributes of the messages a listener wants,
+///        beyond its source and sink filters.
+///
+/// @see ZenohUTransport::registerFilteredListener()
+struct AttributeFilter {
+	/// @brief Accepted message types. Empty accepts all.
+	std::vector<v1::UMessageType> types;
+
+	/// @brief Lowest accepted priority.
+	v1::UPriority min_priority = v1::UPriority::UPRIORITY_UNSPECIFIED;
+	/// @brief Highest accepted priority.
+	v1::UPriority max_priority = v1::UPriority::UPRIORITY_CS6;
+
+	/// @brief Accepted source authorities. Empty accepts all.
+	///
+	/// Compared with the authority in the zenoh key, which is the sender's
+	/// default authority for sources without one.
+	std::vector<std::string> authorities;
+};
+
+/// @brief An AttributeFilter prepared for evaluation on every sample: the
+///        types become a bit mask and the authorities a sorted set.
+class CompiledAttributeFilter {
+public:
+	explicit CompiledAttributeFilter(const AttributeFilter& filter);
+
+	[[nodiscard]] bool matches(const ScannedAttributes& attributes,
+	                           std::string_view source_authority) const;
+
+private:
+	/// @brief Bit N set if type N is accepted.
+	uint32_t types_;
+	v1::UPriority min_priority_;
+	v1::UPriority max_priority_;
+	std::vector<std::string> authorities_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_ATTRIBUTEFILTER_H
@@ -0,0 +1,457 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_COROTRANSPORT_H
+#define UP_TRANSPORT_ZENOH_CPP_COROTRANSPORT_H
+
+#if __cplusplus < 202002L
+#error "CoroTransport.h requires C++20 coroutine support"
+#endif
+
+#include <up-cpp/datamodel/serializer/UUri.h>
+#include <up-cpp/datamodel/serializer/Uuid.h>
+#include <up-cpp/transport/UTransport.h>
+#include <up-cpp/utils/Expected.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace uprotocol::transport::coro {
+
+/// @brief Decides where a suspended coroutine continues once the event it
+///        awaits has happened.
+///
+/// When empty, coroutines are resumed inline on the thread that delivered
+/// the event (a zenoh callback thread, or the RPC deadline thread).
+using Resumer = std::function<void(std::coroutine_handle<>)>;
+
+/// @brief Awaitable result of CoroTransport::send().
+///
+/// zenoh puts never wait for the network, so the message has already been
+/// handed to zenoh by the time this is awaited and it never suspends.
+class SendAwaitable {
+public:
+	explicit SendAwaitable(v1::UStatus&& status) : status_(std::move(status)) {}
+
+	bool await_ready() const noexcept { return true; }
+	void await_suspend(std::coroutine_handle<>) const noexcept {}
+	v1::UStatus await_resume() { return std::move(status_); }
+
+private:
+	v1::UStatus status_;
+};
+
+/// @brief Stream of messages matching a listener registration.
+///
+/// Each `co_await stream.next()` yields the next message, suspending until
+/// one arrives. Only one coroutine may await a given stream at a time.
+/// The registration is removed when the stream is destroyed.
+class MessageStream {
+	struct State {
+		std::mutex mutex;
+		std::deque<v1::UMessage> queue;
+		std::coroutine_handle<> waiter;
+		std::optional<v1::UMessage>* slot = nullptr;
+		Resumer resumer;
+
+		void push(const v1::UMessage& message) {
+			std::coroutine_handle<> ready;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!waiter) {
+					queue.push_back(message);
+					return;
+				}
+				*slot = message;
+				ready = std::exchange(waiter, nullptr);
+			}
+			if (resumer) {
+				resumer(ready);
+			} else {
+				ready.resume();
+			}
+		}
+	};
+
+public:
+	class NextAwaitable {
+	public:
+		explicit NextAwaitable(State& state) : state_(state) {}
+
+		bool await_ready() {
+			std::lock_guard<std::mutex> lock(state_.mutex);
+			return takeQueued();
+		}
+
+		bool await_suspend(std::coroutine_handle<> handle) {
+			std::lock_guard<std::mutex> lock(state_.mutex);
+			if (takeQueued()) {
+				return false;
+			}
+			state_.waiter = handle;
+			state_.slot = &result_;
+			return true;
+		}
+
+		v1::UMessage await_resume() { return std::move(*result_); }
+
+	private:
+		bool takeQueued() {
+			if (state_.queue.empty()) {
+				return false;
+			}
+			result_ = std::move(state_.queue.front());
+			state_.queue.pop_front();
+			return true;
+		}
+
+		State& state_;
+		std::optional<v1::UMessage> result_;
+	};
+
+	/// @brief Awaitable yielding the next message.
+	[[nodiscard]] NextAwaitable next() { return NextAwaitable(*state_); }
+
+private:
+	friend class CoroTransport;
+
+	MessageStream(std::shared_ptr<State> state,
+	              UTransport::ListenHandle&& handle)
+	    : state_(std::move(state)), handle_(std::move(handle)) {}
+
+	std::shared_ptr<State> state_;
+	UTransport::ListenHandle handle_;
+};
+
+/// @brief Coroutine front-end for a UTransport.
+///
+/// Provides `co_await` for sending, streams for receiving and
+/// request/response correlation for RPC. Waiting coroutines are parked as
+/// handles and resumed from the transport's callbacks: no thread is
+/// blocked or spawned per waiter. A single background thread per
+/// CoroTransport enforces RPC deadlines.
+class CoroTransport {
+	using InvokeResult = utils::Expected<v1::UMessage, v1::UStatus>;
+
+	struct Call {
+		v1::UMessage request;
+		std::coroutine_handle<> waiter;
+		std::optional<InvokeResult> result;
+		std::optional<std::multimap<std::chrono::steady_clock::time_point,
+		                            std::string>::iterator>
+		    deadline;
+	};
+
+	struct RpcState {
+		std::shared_ptr<UTransport> transport;
+		Resumer resumer;
+
+		std::mutex mutex;
+		std::condition_variable deadline_cv;
+		bool stopping = false;
+		std::unordered_map<std::string, std::shared_ptr<Call>> pending;
+		std::multimap<std::chrono::steady_clock::time_point, std::string>
+		    deadlines;
+		std::unordered_map<std::string, UTransport::ListenHandle>
+		    response_listeners;
+
+		void resume(std::coroutine_handle<> handle) {
+			if (resumer) {
+				resumer(handle);
+			} else {
+				handle.resume();
+			}
+		}
+
+		// Must be called with mutex held. Removes the call from both
+		// indexes and returns it, or nullptr if it already completed.
+		std::shared_ptr<Call> takeLocked(const std::string& id) {
+			auto it = pending.find(id);
+			if (it == pending.end()) {
+				return nullptr;
+			}
+			auto call = std::move(it->second);
+			pending.erase(it);
+			if (call->deadline) {
+				deadlines.erase(*call->deadline);
+			}
+			return call;
+		}
+
+		void onResponse(const v1::UMessage& response) {
+			if (response.attributes().type() !=
+			    v1::UMessageType::UMESSAGE_TYPE_RESPONSE) {
+				return;
+			}
+			auto id = datamodel::serializer::uuid::AsString::serialize(
+			    response.attributes().reqid());
+			std::shared_ptr<Call> call;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				call = takeLocked(id);
+			}
+			if (call) {
+				call->result.emplace(response);
+				resume(call->waiter);
+			}
+		}
+
+		// Registers one response listener per requesting entity. Must be
+		// called with mutex held.
+		v1::UStatus ensureResponseListenerLocked(
+		    const std::weak_ptr<RpcState>& weak_self,
+		    const v1::UUri& client) {
+			auto key = datamodel::serializer::uri::AsString::serialize(client);
+			if (response_listeners.count(key) != 0) {
+				return {};
+			}
+
+			v1::UUri any_source;
+			any_source.set_authority_name("*");
+			any_source.set_ue_id(0xFFFF);
+			any_source.set_ue_version_major(0xFF);
+			any_source.set_resource_id(0xFFFF);
+
+			auto maybe_handle = transport->registerListener(
+			    any_source,
+			    [weak_self](const v1::UMessage& response) {
+				    if (auto self = weak_self.lock()) {
+					    self->onResponse(response);
+				    }
+			    },
+			    v1::UUri(client));
+			if (!maybe_handle) {
+				return maybe_handle.error();
+			}
+			response_listeners.emplace(std::move(key),
+			                           std::move(maybe_handle).value());
+			return {};
+		}
+
+		// Returns true if the coroutine must stay suspended.
+		bool start(const std::weak_ptr<RpcState>& weak_self,
+		           std::shared_ptr<Call> call,
+		           std::coroutine_handle<> handle) {
+			const auto& attributes = call->request.attributes();
+			auto id = datamodel::serializer::uuid::AsString::serialize(
+			    attributes.id());
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (auto status = ensureResponseListenerLocked(
+				        weak_self, attributes.source());
+				    status.code() != v1::UCode::OK) {
+					call->result.emplace(
+					    utils::Unexpected<v1::UStatus>(std::move(status)));
+					return false;
+				}
+				call->waiter = handle;
+				if (attributes.ttl() > 0) {
+					auto deadline = std::chrono::steady_clock::now() +
+					                std::chrono::milliseconds(attributes.ttl());
+					call->deadline = deadlines.emplace(deadline, id);
+					deadline_cv.notify_one();
+				}
+				pending.emplace(id, call);
+			}
+
+			// From here on the call can complete (and the awaiting frame be
+			// destroyed) on another thread at any time. Only locals are used.
+			auto status = transport->send(call->request);
+			if (status.code() == v1::UCode::OK) {
+				return true;
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!takeLocked(id)) {
+				// Already completed by the deadline thread, which will
+				// resume the coroutine.
+				return true;
+			}
+			call->result.emplace(
+			    utils::Unexpected<v1::UStatus>(std::move(status)));
+			return false;
+		}
+
+		void enforceDeadlines() {
+			std::unique_lock<std::mutex> lock(mutex);
+			while (!stopping) {
+				if (deadlines.empty()) {
+					deadline_cv.wait(lock);
+					continue;
+				}
+				auto next = deadlines.begin()->first;
+				if (std::chrono::steady_clock::now() < next) {
+					deadline_cv.wait_until(lock, next);
+					continue;
+				}
+
+				std::vector<std::shared_ptr<Call>> expired;
+				auto now = std::chrono::steady_clock::now();
+				while (!deadlines.empty() && deadlines.begin()->first <= now) {
+					std::string id = deadlines.begin()->second;
+					if (auto call = takeLocked(id)) {
+						expired.push_back(std::move(call));
+					} else {
+						deadlines.erase(deadlines.begin());
+					}
+				}
+
+				lock.unlock();
+				for (auto& call : expired) {
+					v1::UStatus status;
+					status.set_code(v1::UCode::DEADLINE_EXCEEDED);
+					status.set_message("RPC response not received within TTL");
+					call->result.emplace(
+					    utils::Unexpected<v1::UStatus>(std::move(status)));
+					resume(call->waiter);
+				}
+				lock.lock();
+			}
+		}
+
+		void cancelAll() {
+			std::vector<std::shared_ptr<Call>> cancelled;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				for (auto& [id, call] : pending) {
+					cancelled.push_back(std::move(call));
+				}
+				pending.clear();
+				deadlines.clear();
+			}
+			for (auto& call : cancelled) {
+				v1::UStatus status;
+				status.set_code(v1::UCode::CANCELLED);
+				status.set_message("CoroTransport destroyed");
+				call->result.emplace(
+				    utils::Unexpected<v1::UStatus>(std::move(status)));
+				resume(call->waiter);
+			}
+		}
+	};
+
+public:
+	/// @brief Awaitable result of CoroTransport::invokeMethod().
+	class InvokeAwaitable {
+	public:
+		bool await_ready() const noexcept { return false; }
+
+		bool await_suspend(std::coroutine_handle<> handle) {
+			return rpc_->start(rpc_, call_, handle);
+		}
+
+		InvokeResult await_resume() { return std::move(*call_->result); }
+
+	private:
+		friend class CoroTransport;
+
+		InvokeAwaitable(std::shared_ptr<RpcState> rpc,
+		                std::shared_ptr<Call> call)
+		    : rpc_(std::move(rpc)), call_(std::move(call)) {}
+
+		std::shared_ptr<RpcState> rpc_;
+		std::shared_ptr<Call> call_;
+	};
+
+	/// @param transport Transport used for all operations.
+	/// @param resumer (Optional) executor for resumed coroutines. See
+	///                Resumer.
+	explicit CoroTransport(std::shared_ptr<UTransport> transport,
+	                       Resumer resumer = {})
+	    : rpc_(std::make_shared<RpcState>()) {
+		rpc_->transport = std::move(transport);
+		rpc_->resumer = std::move(resumer);
+		deadline_thread_ = std::thread([rpc = rpc_]() {
+			rpc->enforceDeadlines();
+		});
+	}
+
+	/// @brief Stops deadline tracking. Outstanding RPCs complete with
+	///        CANCELLED before this returns.
+	~CoroTransport() {
+		{
+			std::lock_guard<std::mutex> lock(rpc_->mutex);
+			rpc_->stopping = true;
+		}
+		rpc_->deadline_cv.notify_one();
+		deadline_thread_.join();
+		rpc_->cancelAll();
+
+		// Handles are released outside the lock: dropping one may wait for
+		// an in-flight response callback, which takes the same lock.
+		decltype(rpc_->response_listeners) listeners;
+		{
+			std::lock_guard<std::mutex> lock(rpc_->mutex);
+			listeners.swap(rpc_->response_listeners);
+		}
+	}
+
+	CoroTransport(const CoroTransport&) = delete;
+	CoroTransport& operator=(const CoroTransport&) = delete;
+
+	/// @brief `co_await send(message)` sends a message and yields its
+	///        UStatus.
+	[[nodiscard]] SendAwaitable send(const v1::UMessage& message) {
+		return SendAwaitable(rpc_->transport->send(message));
+	}
+
+	/// @brief Opens a stream over all messages matching the filters.
+	///
+	/// @returns * A MessageStream if the listener was registered.
+	///          * FAILSTATUS with the appropriate failure otherwise.
+	[[nodiscard]] utils::Expected<MessageStream, v1::UStatus> listen(
+	    const v1::UUri& source_filter,
+	    std::optional<v1::UUri>&& sink_filter = {}) {
+		auto state = std::make_shared<MessageStream::State>();
+		state->resumer = rpc_->resumer;
+		auto maybe_handle = rpc_->transport->registerListener(
+		    source_filter,
+		    [state](const v1::UMessage& message) { state->push(message); },
+		    std::move(sink_filter));
+		if (!maybe_handle) {
+			return utils::Unexpected<v1::UStatus>(maybe_handle.error());
+		}
+		return MessageStream(std::move(state), std::move(maybe_handle).value());
+	}
+
+	/// @brief `co_await invokeMethod(request)` sends an RPC request and
+	///        yields the matching response.
+	///
+	/// @param request Fully built request message (see
+	///                datamodel::builder::UMessageBuilder::request). Its id
+	///                is used for correlation and its TTL as the deadline.
+	///
+	/// @returns Awaitable yielding either the response message or a
+	///          UStatus (send failure, DEADLINE_EXCEEDED or CANCELLED).
+	[[nodiscard]] InvokeAwaitable invokeMethod(v1::UMessage&& request) {
+		auto call = std::make_shared<Call>();
+		call->request = std::move(request);
+		return InvokeAwaitable(rpc_, std::move(call));
+	}
+
+private:
+	std::shared_ptr<RpcState> rpc_;
+	std::thread deadline_thread_;
+};
+
+}  // namespace uprotocol::transport::coro
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_COROTRANSPORT_H
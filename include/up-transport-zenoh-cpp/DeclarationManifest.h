@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_DECLARATIONMANIFEST_H
+#define UP_TRANSPORT_ZENOH_CPP_DECLARATIONMANIFEST_H
+
+#include <up-core-api/uattributes.pb.h>
+#include <up-core-api/uuri.pb.h>
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace uprotocol::transport {
+
+/// @brief Topics an entity will publish and listen on, declared up front so
+///        that the first messages do not pay declaration latency.
+struct DeclarationManifest {
+	/// @brief Messages this entity will send.
+	///
+	/// A zenoh publisher is declared for each entry. Messages sent later
+	/// with the same source, sink and priority go through it.
+	struct Publication {
+		v1::UUri source;
+		/// @brief Sink for notifications, requests and responses. Empty for
+		///        publish messages.
+		std::optional<v1::UUri> sink;
+		v1::UPriority priority = v1::UPriority::UPRIORITY_CS1;
+	};
+
+	/// @brief Filters this entity will register listeners with.
+	///
+	/// A zenoh subscriber is declared for each entry and handed over to
+	/// the first listener later registered with the same filters.
+	struct Subscription {
+		v1::UUri source_filter;
+		std::optional<v1::UUri> sink_filter;
+	};
+
+	std::vector<Publication> publications;
+	std::vector<Subscription> subscriptions;
+};
+
+/// @brief Outcome of declaring a DeclarationManifest.
+struct WarmUpReport {
+	/// @brief Wall time spent declaring everything.
+	std::chrono::microseconds duration{0};
+	size_t publishers = 0;
+	size_t subscribers = 0;
+	/// @brief Zenoh keys whose declaration failed.
+	std::vector<std::string> failed_keys;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_DECLARATIONMANIFEST_H
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_EVENTFDRECEIVER_H
+#define UP_TRANSPORT_ZENOH_CPP_EVENTFDRECEIVER_H
+
+#include <up-core-api/umessage.pb.h>
+#include <up-cpp/transport/UTransport.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace uprotocol::transport {
+
+/// @brief Options for an eventfd-signalled listener registration.
+struct EventFdReceiverOptions {
+	/// @brief What to do with a message arriving while the queue is full.
+	enum class Overflow {
+		/// Drop the arriving message.
+		DropNewest,
+		/// Drop the oldest queued message to make room.
+		DropOldest
+	};
+
+	/// @brief Maximum number of messages queued until drained.
+	size_t capacity = 1024;
+
+	Overflow overflow = Overflow::DropNewest;
+};
+
+/// @brief Handle for a listener registration that signals readiness through
+///        an eventfd instead of invoking a callback.
+///
+/// Messages are queued as they arrive on zenoh's threads and the eventfd
+/// becomes readable. An event loop (epoll, poll, select...) watches fd() and
+/// calls drain() from its own thread when it fires. The registration is
+/// removed when the handle is destroyed.
+class EventFdReceiver {
+public:
+	/// @brief Queue shared between the delivering callback and the owner.
+	///
+	/// Owns the eventfd so that it stays open for as long as a callback
+	/// might still signal it.
+	struct Queue {
+		Queue(int event_fd, const EventFdReceiverOptions& options);
+		~Queue();
+
+		Queue(const Queue&) = delete;
+		Queue& operator=(const Queue&) = delete;
+
+		/// @brief Queue a message, signalling the eventfd only if the
+		///        queue was empty, as it is already readable otherwise.
+		void push(const v1::UMessage& message);
+
+		const int fd;
+		const size_t capacity;
+		const EventFdReceiverOptions::Overflow overflow;
+		std::mutex mutex;
+		std::deque<v1::UMessage> messages;
+		std::atomic<uint64_t> dropped{0};
+	};
+
+	EventFdReceiver(std::shared_ptr<Queue> queue,
+	                UTransport::ListenHandle&& handle);
+
+	EventFdReceiver(EventFdReceiver&&) = default;
+	EventFdReceiver& operator=(EventFdReceiver&&) = default;
+
+	/// @brief File descriptor that is readable while messages are queued.
+	///
+	/// The descriptor is non-blocking and remains owned by this handle. Do
+	/// not read from or close it directly; use drain().
+	[[nodiscard]] int fd() const { return queue_->fd; }
+
+	/// @brief Move up to max queued messages into out.
+	///
+	/// Clears the readiness signal. If messages remain queued afterwards,
+	/// the descriptor is re-armed so that the event loop fires again.
+	///
+	/// @returns Number of messages appended to out.
+	size_t drain(std::vector<v1::UMessage>& out,
+	             size_t max = std::numeric_limits<size_t>::max());
+
+	/// @brief Messages dropped because the queue was full.
+	[[nodiscard]] uint64_t dropped() const { return queue_->dropped; }
+
+private:
+	std::shared_ptr<Queue> queue_;
+	UTransport::ListenHandle handle_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_EVENTFDRECEIVER_H
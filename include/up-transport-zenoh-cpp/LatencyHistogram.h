@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_LATENCYHISTOGRAM_H
+#define UP_TRANSPORT_ZENOH_CPP_LATENCYHISTOGRAM_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace uprotocol::transport {
+
+/// @brief Fixed-size log-linear histogram of latencies, in the style of
+///        HdrHistogram.
+///
+/// Values are in microseconds. Each power of two is split into 32 linear
+/// buckets, so any recorded value is reported within about 3% of its true
+/// value, from 1 us up to 2^32 us (over an hour). Larger values are
+/// clamped. Memory use is constant, whatever is recorded.
+class LatencyHistogram {
+public:
+	static constexpr size_t SUB_BUCKET_BITS = 5;
+	static constexpr size_t SUB_BUCKET_COUNT = size_t{1} << SUB_BUCKET_BITS;
+	static constexpr size_t MAX_MAGNITUDE = 31;
+	static constexpr size_t BUCKET_COUNT =
+	    SUB_BUCKET_COUNT +
+	    (MAX_MAGNITUDE + 1 - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT;
+
+	/// @brief Bucket holding the given value.
+	static size_t bucketFor(std::chrono::microseconds latency);
+
+	/// @brief Largest value held by the given bucket.
+	static std::chrono::microseconds bucketUpperBound(size_t bucket);
+
+	void record(std::chrono::microseconds latency) {
+		++counts_[bucketFor(latency)];
+	}
+
+	/// @brief Add count values to a bucket, e.g. when merging histograms.
+	void add(size_t bucket, uint64_t count) { counts_[bucket] += count; }
+
+	void merge(const LatencyHistogram& other);
+
+	/// @brief Number of recorded values.
+	[[nodiscard]] uint64_t count() const;
+
+	/// @brief Value below or at which the given fraction of recorded
+	///        values fall, e.g. 0.99 for p99. Zero if nothing was recorded.
+	[[nodiscard]] std::chrono::microseconds percentile(double fraction) const;
+
+	/// @brief Upper bound of the largest recorded value.
+	[[nodiscard]] std::chrono::microseconds max() const;
+
+	[[nodiscard]] const std::array<uint64_t, BUCKET_COUNT>& counts() const {
+		return counts_;
+	}
+
+private:
+	std::array<uint64_t, BUCKET_COUNT> counts_{};
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_LATENCYHISTOGRAM_H
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_PERTHREAD_H
+#define UP_TRANSPORT_ZENOH_CPP_PERTHREAD_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace uprotocol::transport {
+
+/// @brief One T per thread and per instance, reachable from any thread.
+///
+/// A thread finds its own T through a thread-local cache, without taking
+/// any lock after the first call. Other threads can visit every T with
+/// forEach(). Ts outlive the threads that created them, and are destroyed
+/// with the PerThread instance.
+template <typename T>
+class PerThread {
+public:
+	PerThread() : id_(nextId()) {}
+
+	PerThread(const PerThread&) = delete;
+	PerThread& operator=(const PerThread&) = delete;
+
+	/// @brief The calling thread's T, constructed from args on first use.
+	template <typename... Args>
+	T& local(Args&&... args) {
+		struct Cached {
+			T* value;
+			/// Expires with the owning instance, allowing the entry to be
+			/// pruned.
+			std::weak_ptr<T> owner;
+		};
+		thread_local std::unordered_map<uint64_t, Cached> cache;
+
+		auto cached = cache.find(id_);
+		if (cached != cache.end()) {
+			return *cached->second.value;
+		}
+
+		for (auto entry = cache.begin(); entry != cache.end();) {
+			if (entry->second.owner.expired()) {
+				entry = cache.erase(entry);
+			} else {
+				++entry;
+			}
+		}
+
+		auto value = std::make_shared<T>(std::forward<Args>(args)...);
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			values_.push_back(value);
+		}
+		cache.emplace(id_, Cached{value.get(), value});
+		return *value;
+	}
+
+	/// @brief Call visit with every thread's T. T must synchronize with
+	///        its owning thread itself.
+	template <typename Visit>
+	void forEach(Visit&& visit) const {
+		std::vector<std::shared_ptr<T>> values;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			values = values_;
+		}
+		for (const auto& value : values) {
+			visit(*value);
+		}
+	}
+
+private:
+	static uint64_t nextId() {
+		static std::atomic<uint64_t> next{0};
+		return next++;
+	}
+
+	/// @brief Never reused, so that a thread's cached T for a destroyed
+	///        instance cannot be mistaken for a live one.
+	const uint64_t id_;
+
+	mutable std::mutex mutex_;
+	std::vector<std::shared_ptr<T>> values_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_PERTHREAD_H
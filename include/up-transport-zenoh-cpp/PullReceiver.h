@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_PULLRECEIVER_H
+#define UP_TRANSPORT_ZENOH_CPP_PULLRECEIVER_H
+
+#include <up-core-api/umessage.pb.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <variant>
+#include <vector>
+
+#define ZENOHCXX_ZENOHC
+#include <zenoh.hxx>
+
+namespace uprotocol::transport {
+
+/// @brief Options for a pull-based listener registration.
+struct PullReceiverOptions {
+	/// @brief Behavior of the PullReceiver::Queue backing the
+	///        registration when full. Named after the zenoh channels it
+	///        behaves like.
+	enum class Channel {
+		/// Bounded FIFO. When full, the delivering zenoh thread blocks,
+		/// applying back-pressure until the consumer drains.
+		Fifo,
+		/// Bounded ring. When full, the oldest sample is dropped.
+		Ring
+	};
+
+	Channel channel = Channel::Fifo;
+
+	/// @brief Maximum number of samples buffered.
+	size_t capacity = 256;
+};
+
+/// @brief Handle for a pull-based listener registration.
+///
+/// Samples matching the registered filters are buffered in a Queue, which
+/// blocks or drops the oldest sample when full, and decoded only when the
+/// owner drains them, on the owner's thread. The underlying subscriber is
+/// undeclared when the handle is destroyed.
+class PullReceiver {
+public:
+	/// @brief Samples buffered between the subscriber callback and the
+	///        owner.
+	///
+	/// Replaces zenoh's FIFO and ring channel handlers, which it otherwise
+	/// behaves like. Those offer no timed receive, so waiting for a sample
+	/// would mean polling, and only take samples from zenoh, while copies
+	/// of coalesced responses are pushed as decoded messages. This queue
+	/// lets recvMany() sleep on a condition that the delivering thread
+	/// signals instead.
+	struct Queue {
+		explicit Queue(const PullReceiverOptions& options);
+
+		Queue(const Queue&) = delete;
+		Queue& operator=(const Queue&) = delete;
+
+		/// @brief Called on zenoh's threads. Blocks while a FIFO queue is
+		///        full, until the owner drains or the queue is closed.
+		void push(zenoh::Sample&& sample);
+
+		/// @brief Buffer a message decoded already, such as a response
+		///        copied for a coalesced request. Blocks like the above.
+		void push(v1::UMessage&& message);
+
+		/// @brief Stop accepting samples and release blocked push() calls.
+		void close();
+
+		const PullReceiverOptions::Channel channel;
+		const size_t capacity;
+
+		std::mutex mutex;
+		/// @brief Signalled when the queue becomes non-empty or closed.
+		std::condition_variable ready;
+		/// @brief Signalled when a full FIFO queue is drained.
+		std::condition_variable space;
+		/// @brief Samples, decoded by the owner, or messages.
+		std::deque<std::variant<zenoh::Sample, v1::UMessage>> samples;
+		bool closed = false;
+
+	private:
+		template <typename Entry>
+		void pushEntry(Entry&& entry);
+	};
+
+	PullReceiver(std::shared_ptr<Queue> queue,
+	             zenoh::Subscriber<void>&& subscriber);
+
+	/// @brief Closes the queue, so that a delivering thread blocked on it
+	///        returns before the subscriber is undeclared.
+	~PullReceiver();
+
+	PullReceiver(PullReceiver&&) = default;
+	PullReceiver& operator=(PullReceiver&& other) noexcept;
+
+	/// @brief Receive one message without waiting.
+	///
+	/// @returns The oldest buffered message, or std::nullopt if none is
+	///          available.
+	[[nodiscard]] std::optional<v1::UMessage> tryRecv();
+
+	/// @brief Drain up to max buffered messages into out.
+	///
+	/// Waits at most timeout for the first message to arrive. Once at least
+	/// one message is available, everything else already buffered (up to
+	/// max) is appended without further waiting.
+	///
+	/// @param out Messages are appended to this vector so that its storage
+	///            can be reused between calls.
+	/// @param max Maximum number of messages to append.
+	/// @param timeout Maximum time to wait when nothing is buffered.
+	///
+	/// @returns Number of messages appended to out.
+	size_t recvMany(std::vector<v1::UMessage>& out, size_t max,
+	                std::chrono::milliseconds timeout =
+	                    std::chrono::milliseconds::zero());
+
+	/// @brief True once the subscriber has been dropped by zenoh and no
+	///        further messages can arrive.
+	[[nodiscard]] bool isDisconnected() const { return disconnected_; }
+
+private:
+	/// @brief Decode up to max buffered samples into out, waiting until
+	///        deadline for the first one if none is buffered.
+	size_t drain(std::vector<v1::UMessage>& out, size_t max,
+	             std::optional<std::chrono::steady_clock::time_point>
+	                 deadline = std::nullopt);
+
+	std::shared_ptr<Queue> queue_;
+	zenoh::Subscriber<void> subscriber_;
+	bool disconnected_ = false;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_PULLRECEIVER_H
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_REAPER_H
+#define UP_TRANSPORT_ZENOH_CPP_REAPER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace uprotocol::transport {
+
+/// @brief Destroys values on a background thread, for values whose
+///        destructor may block, such as zenoh subscribers undeclaring
+///        themselves.
+///
+/// The thread is started on first use. Values still queued when the
+/// Reaper is destroyed are destroyed by its destructor.
+template <typename Value>
+class Reaper {
+public:
+	Reaper() = default;
+
+	~Reaper() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopping_ = true;
+		}
+		cv_.notify_all();
+		if (thread_.joinable()) {
+			thread_.join();
+		}
+	}
+
+	Reaper(const Reaper&) = delete;
+	Reaper& operator=(const Reaper&) = delete;
+
+	/// @brief Queue a value for destruction. Never blocks on the value.
+	void dispose(Value&& value) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			queue_.push_back(std::move(value));
+			if (!thread_.joinable()) {
+				thread_ = std::thread([this]() { run(); });
+			}
+		}
+		cv_.notify_one();
+	}
+
+	/// @brief Values queued or being destroyed.
+	[[nodiscard]] size_t pending() const {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return queue_.size() + busy_;
+	}
+
+private:
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex_);
+		while (true) {
+			cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+			if (queue_.empty()) {
+				return;
+			}
+			std::deque<Value> batch;
+			batch.swap(queue_);
+			busy_ = batch.size();
+			lock.unlock();
+			batch.clear();
+			lock.lock();
+			busy_ = 0;
+		}
+	}
+
+	mutable std::mutex mutex_;
+	std::condition_variable cv_;
+	std::deque<Value> queue_;
+	size_t busy_ = 0;
+	bool stopping_ = false;
+	std::thread thread_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_REAPER_H
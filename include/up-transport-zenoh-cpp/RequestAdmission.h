@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_REQUESTADMISSION_H
+#define UP_TRANSPORT_ZENOH_CPP_REQUESTADMISSION_H
+
+#include <up-core-api/uattributes.pb.h>
+#include <up-core-api/uuri.pb.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace uprotocol::transport {
+
+/// @brief How many requests to one method are handled and kept waiting.
+struct MethodAdmissionLimits {
+	/// @brief Requests handled at the same time.
+	size_t max_concurrent = 1;
+
+	/// @brief Requests waiting for one of the max_concurrent slots. Once
+	///        full, the lowest priority request is rejected.
+	size_t queue_capacity = 64;
+};
+
+/// @brief Admission control for requests received by RPC servers.
+///
+/// Requests are normally handled on zenoh's callback thread as they
+/// arrive, and pile up there when a server falls behind, until most of
+/// them have expired by the time they are handled. With admission control,
+/// requests are handled on a pool of worker threads, up to a limit per
+/// method. Requests beyond that limit wait in a bounded queue per method
+/// and are handled highest priority first. When the queue is full, the
+/// lowest priority request is rejected with a RESOURCE_EXHAUSTED response,
+/// so that its client fails fast instead of timing out. Requests whose TTL
+/// runs out while waiting are dropped.
+struct RequestAdmissionOptions {
+	/// @brief Threads handling admitted requests, for all methods. Zero
+	///        disables admission control.
+	size_t worker_threads = 0;
+
+	/// @brief Limits for methods not listed in methods.
+	MethodAdmissionLimits default_limits;
+
+	/// @brief Limits for specific methods, by method URI. The authority
+	///        is ignored.
+	std::vector<std::pair<v1::UUri, MethodAdmissionLimits>> methods;
+};
+
+/// @brief Schedules requests onto worker threads under per-method limits.
+///
+/// @see RequestAdmissionOptions
+class RequestAdmission {
+public:
+	struct Request {
+		v1::UPriority priority = v1::UPriority::UPRIORITY_UNSPECIFIED;
+		/// @brief Empty if the request never expires.
+		std::optional<std::chrono::system_clock::time_point> deadline;
+		/// @brief Handles the request on a worker thread.
+		std::function<void()> handle;
+		/// @brief Called instead of handle if the request is shed.
+		std::function<void()> reject;
+		/// @brief Called instead of handle if the request expired before
+		///        it could be handled.
+		std::function<void()> expire;
+	};
+
+	explicit RequestAdmission(RequestAdmissionOptions options);
+
+	/// @brief Waits for the requests being handled. Waiting requests are
+	///        dropped.
+	~RequestAdmission();
+
+	RequestAdmission(const RequestAdmission&) = delete;
+	RequestAdmission& operator=(const RequestAdmission&) = delete;
+
+	/// @brief Handle, queue, reject or expire a request to method.
+	///
+	/// Never blocks on the handling of other requests. reject and expire
+	/// may be called on the calling thread, for this or for a lower
+	/// priority request.
+	void submit(const v1::UUri& method, Request&& request);
+
+private:
+	/// @brief UPriority values, CS0 to CS6 after UNSPECIFIED.
+	static constexpr size_t PRIORITY_BANDS = 8;
+
+	struct Method {
+		MethodAdmissionLimits limits;
+		size_t running = 0;
+		size_t waiting = 0;
+		/// @brief Waiting requests by priority, oldest first.
+		std::array<std::deque<Request>, PRIORITY_BANDS> queues;
+	};
+
+	/// @brief Identifies a method regardless of its authority.
+	static uint64_t methodId(const v1::UUri& method);
+
+	static size_t band(v1::UPriority priority);
+
+	/// @brief Take the highest priority waiting request of method, moving
+	///        expired ones to expired. Called with mutex_ held.
+	std::optional<Request> next(Method& method,
+	                            std::vector<Request>& expired);
+
+	void runWorker();
+
+	const RequestAdmissionOptions options_;
+
+	std::mutex mutex_;
+	std::condition_variable ready_cv_;
+	std::unordered_map<uint64_t, Method> methods_;
+	/// @brief Admitted requests waiting for a worker.
+	std::deque<std::pair<Method*, Request>> ready_;
+	bool stopping_ = false;
+	std::vector<std::thread> workers_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_REQUESTADMISSION_H
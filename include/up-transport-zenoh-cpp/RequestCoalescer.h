@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_REQUESTCOALESCER_H
+#define UP_TRANSPORT_ZENOH_CPP_REQUESTCOALESCER_H
+
+#include <up-core-api/uattributes.pb.h>
+#include <up-core-api/uuri.pb.h>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "RequestId.h"
+
+namespace uprotocol::transport {
+
+/// @brief Requests in flight that identical requests can share.
+///
+/// @see RequestCoalescingOptions
+class RequestCoalescer {
+public:
+	explicit RequestCoalescer(const std::vector<v1::UUri>& methods);
+
+	/// @brief Join an identical request in flight, if there is one.
+	///
+	/// @returns true if the request joined another and must not be sent.
+	///          Otherwise it is sent, and others can join it if its method
+	///          is coalesced and it has a TTL.
+	bool join(const v1::UAttributes& request, const std::string& payload);
+
+	/// @brief Forget a request that could not be sent.
+	void abandon(const v1::UUID& request_id);
+
+	/// @brief End the flight of an answered request.
+	///
+	/// @returns The ids of the requests that joined it.
+	std::vector<v1::UUID> complete(const v1::UUID& request_id);
+
+private:
+	struct Flight {
+		RequestId leader;
+		/// @brief Compared in full, as only its hash is in the key.
+		std::string payload;
+		/// @brief Requests no longer join once the leader has expired.
+		std::chrono::steady_clock::time_point deadline;
+		std::vector<RequestId> followers;
+	};
+
+	static uint64_t methodId(const v1::UUri& method);
+
+	/// @brief Source, method, payload format and payload hash.
+	static std::string flightKey(const v1::UAttributes& request,
+	                             const std::string& payload);
+
+	/// @brief Remove the flight led by request_id. Called with mutex_
+	///        held.
+	std::vector<RequestId> land(const v1::UUID& request_id);
+
+	/// @brief Drop flights whose leader expired without a response.
+	///        Called with mutex_ held.
+	void sweep(std::chrono::steady_clock::time_point now);
+
+	std::unordered_set<uint64_t> methods_;
+
+	std::mutex mutex_;
+	std::unordered_map<std::string, Flight> flights_;
+	/// @brief Key of each flight, by leader.
+	std::unordered_map<RequestId, std::string, RequestIdHash> leaders_;
+	/// @brief Flight count at which expired flights are next swept.
+	size_t sweep_at_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_REQUESTCOALESCER_H
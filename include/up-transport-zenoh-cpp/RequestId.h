@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_REQUESTID_H
+#define UP_TRANSPORT_ZENOH_CPP_REQUESTID_H
+
+#include <up-core-api/uuid.pb.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace uprotocol::transport {
+
+/// @brief A message id as a hashable value, for correlating responses with
+///        requests without serializing the UUID.
+struct RequestId {
+	uint64_t msb = 0;
+	uint64_t lsb = 0;
+
+	static RequestId of(const v1::UUID& id) { return {id.msb(), id.lsb()}; }
+
+	[[nodiscard]] v1::UUID uuid() const {
+		v1::UUID id;
+		id.set_msb(msb);
+		id.set_lsb(lsb);
+		return id;
+	}
+
+	bool operator==(const RequestId& other) const {
+		return msb == other.msb && lsb == other.lsb;
+	}
+};
+
+struct RequestIdHash {
+	size_t operator()(const RequestId& id) const {
+		// The low bits of a UUIDv7 are random.
+		return static_cast<size_t>(id.lsb ^ (id.msb * 0x9E3779B97F4A7C15ULL));
+	}
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_REQUESTID_H
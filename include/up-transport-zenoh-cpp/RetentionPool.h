@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_RETENTIONPOOL_H
+#define UP_TRANSPORT_ZENOH_CPP_RETENTIONPOOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace uprotocol::transport {
+
+/// @brief Counters of a RetentionPool.
+struct RetentionStats {
+	/// @brief take() calls that found a retained value.
+	uint64_t hits = 0;
+	/// @brief take() calls that found none.
+	uint64_t misses = 0;
+	/// @brief Values dropped at the end of their grace period.
+	uint64_t expired = 0;
+	/// @brief Values dropped early to stay within capacity.
+	uint64_t evicted = 0;
+	/// @brief Values currently retained.
+	size_t retained = 0;
+};
+
+/// @brief Bounded set of idle values, keyed by string, each kept for a
+///        grace period in case it is needed again.
+///
+/// Values are dropped, oldest first, when their grace period ends or when
+/// the pool is full. They are never destroyed under the pool's lock:
+/// expired values are destroyed by a background thread, and evicted ones
+/// are returned to the caller.
+template <typename Value>
+class RetentionPool {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	RetentionPool(size_t capacity, Clock::duration grace_period)
+	    : capacity_(capacity), grace_period_(grace_period) {
+		sweeper_ = std::thread([this]() { sweep(); });
+	}
+
+	~RetentionPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopping_ = true;
+		}
+		cv_.notify_all();
+		sweeper_.join();
+	}
+
+	RetentionPool(const RetentionPool&) = delete;
+	RetentionPool& operator=(const RetentionPool&) = delete;
+
+	/// @brief Retain a value no longer in use.
+	///
+	/// @returns Values evicted to make room, for the caller to destroy
+	///          where it sees fit.
+	std::vector<Value> park(const std::string& key, Value&& value) {
+		std::vector<Value> evicted;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			entries_.push_back(
+			    {key, Clock::now() + grace_period_, std::move(value)});
+			index_.emplace(key, std::prev(entries_.end()));
+			while (entries_.size() > capacity_) {
+				evicted.push_back(removeOldest());
+				++stats_.evicted;
+			}
+		}
+		cv_.notify_one();
+		return evicted;
+	}
+
+	/// @brief Take back a value retained under key, if any.
+	std::optional<Value> take(const std::string& key) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto indexed = index_.find(key);
+		if (indexed == index_.end()) {
+			++stats_.misses;
+			return std::nullopt;
+		}
+		++stats_.hits;
+		auto entry = indexed->second;
+		index_.erase(indexed);
+		Value value = std::move(entry->value);
+		entries_.erase(entry);
+		return value;
+	}
+
+	[[nodiscard]] RetentionStats stats() const {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto stats = stats_;
+		stats.retained = entries_.size();
+		return stats;
+	}
+
+private:
+	struct Entry {
+		std::string key;
+		Clock::time_point deadline;
+		Value value;
+	};
+
+	/// @brief Requires mutex_.
+	Value removeOldest() {
+		auto oldest = entries_.begin();
+		auto range = index_.equal_range(oldest->key);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second == oldest) {
+				index_.erase(it);
+				break;
+			}
+		}
+		Value value = std::move(oldest->value);
+		entries_.pop_front();
+		return value;
+	}
+
+	void sweep() {
+		std::unique_lock<std::mutex> lock(mutex_);
+		while (!stopping_) {
+			if (entries_.empty()) {
+				cv_.wait(lock);
+				continue;
+			}
+			// Grace periods are equal, so the oldest entry expires first.
+			if (Clock::now() < entries_.front().deadline) {
+				cv_.wait_until(lock, entries_.front().deadline);
+				continue;
+			}
+
+			std::vector<Value> expired;
+			while (!entries_.empty() &&
+			       Clock::now() >= entries_.front().deadline) {
+				expired.push_back(removeOldest());
+				++stats_.expired;
+			}
+			lock.unlock();
+			expired.clear();
+			lock.lock();
+		}
+	}
+
+	const size_t capacity_;
+	const Clock::duration grace_period_;
+
+	mutable std::mutex mutex_;
+	std::condition_variable cv_;
+	/// @brief Oldest first.
+	std::list<Entry> entries_;
+	std::unordered_multimap<std::string, typename std::list<Entry>::iterator>
+	    index_;
+	RetentionStats stats_;
+	bool stopping_ = false;
+	std::thread sweeper_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_RETENTIONPOOL_H
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_RPCDEADLINETRACKER_H
+#define UP_TRANSPORT_ZENOH_CPP_RPCDEADLINETRACKER_H
+
+#include <up-core-api/uattributes.pb.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "RequestId.h"
+#include "TimingWheel.h"
+#include "ZenohUTransportOptions.h"
+
+namespace uprotocol::transport {
+
+/// @brief Deadlines of outstanding requests, reported in batches from a
+///        thread of its own.
+///
+/// @see RpcDeadlineOptions
+class RpcDeadlineTracker {
+public:
+	explicit RpcDeadlineTracker(RpcDeadlineOptions options);
+
+	/// @brief Stops reporting. Requests still tracked are not reported.
+	~RpcDeadlineTracker();
+
+	RpcDeadlineTracker(const RpcDeadlineTracker&) = delete;
+	RpcDeadlineTracker& operator=(const RpcDeadlineTracker&) = delete;
+
+	/// @brief Start tracking a request about to be sent. Requests without
+	///        a TTL are ignored.
+	void track(const v1::UAttributes& request);
+
+	/// @brief Stop tracking a request, because it was answered or could not
+	///        be sent.
+	///
+	/// @returns false if the request was not tracked, or had expired.
+	bool complete(const v1::UUID& request_id);
+
+	/// @brief Requests tracked and not yet reported.
+	[[nodiscard]] size_t pending() const;
+
+private:
+	void run();
+
+	const RpcDeadlineOptions options_;
+
+	mutable std::mutex mutex_;
+	std::condition_variable cv_;
+	TimingWheel<RequestId, v1::UUri, RequestIdHash> wheel_;
+	bool stopping_ = false;
+	std::thread reporter_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_RPCDEADLINETRACKER_H
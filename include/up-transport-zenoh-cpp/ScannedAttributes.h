@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_SCANNEDATTRIBUTES_H
+#define UP_TRANSPORT_ZENOH_CPP_SCANNEDATTRIBUTES_H
+
+#include <up-core-api/uattributes.pb.h>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace uprotocol::transport {
+
+/// @brief The scalar fields of a serialized UAttributes, read without
+///        decoding the message.
+///
+/// Deciding whether a message is wanted from these fields lets it be
+/// dropped before the full ParseFromString() and before its payload is
+/// copied.
+struct ScannedAttributes {
+	uint64_t id_msb = 0;
+	uint64_t id_lsb = 0;
+	/// @brief Id of the request a response answers; zero otherwise.
+	uint64_t reqid_msb = 0;
+	uint64_t reqid_lsb = 0;
+	v1::UMessageType type = v1::UMessageType::UMESSAGE_TYPE_UNSPECIFIED;
+	v1::UPriority priority = v1::UPriority::UPRIORITY_UNSPECIFIED;
+	uint32_t ttl = 0;
+	std::optional<uint32_t> permission_level;
+	std::optional<v1::UCode> commstatus;
+	v1::UPayloadFormat payload_format =
+	    v1::UPayloadFormat::UPAYLOAD_FORMAT_UNSPECIFIED;
+
+	/// @brief Read the fields above from the protobuf wire format.
+	///
+	/// Other fields, such as the source, sink and strings, are skipped over
+	/// without being decoded or validated. Whenever
+	/// UAttributes::ParseFromString() accepts the input, scan() accepts it
+	/// too and yields the same values. It may accept input that
+	/// ParseFromString() rejects because of a skipped field.
+	///
+	/// @returns std::nullopt if the input is not well-formed protobuf.
+	static std::optional<ScannedAttributes> scan(std::string_view serialized);
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_SCANNEDATTRIBUTES_H
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_SESSIONPOOL_H
+#define UP_TRANSPORT_ZENOH_CPP_SESSIONPOOL_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#define ZENOHCXX_ZENOHC
+#include <zenoh.hxx>
+
+namespace uprotocol::transport {
+
+/// @brief Process-wide registry of zenoh sessions shared between transport
+///        instances.
+///
+/// Sessions are keyed by a string identifying the configuration they were
+/// opened with. A session stays open for as long as at least one transport
+/// holds it and is closed when the last holder releases it.
+class SessionPool {
+public:
+	using Opener = std::function<zenoh::Session()>;
+
+	/// @brief Get the session registered under key, opening it with open()
+	///        if no live session exists for that key.
+	///
+	/// @throws Whatever open() throws. Nothing is registered in that case.
+	static std::shared_ptr<zenoh::Session> acquire(const std::string& key,
+	                                               const Opener& open);
+
+	/// @brief Number of live sessions currently in the pool.
+	static size_t size();
+
+private:
+	static std::mutex mutex_;
+	static std::map<std::string, std::weak_ptr<zenoh::Session>> sessions_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_SESSIONPOOL_H
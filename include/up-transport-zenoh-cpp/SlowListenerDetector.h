@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_SLOWLISTENERDETECTOR_H
+#define UP_TRANSPORT_ZENOH_CPP_SLOWLISTENERDETECTOR_H
+
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LatencyHistogram.h"
+
+namespace uprotocol::transport {
+
+/// @brief A listener invocation that exceeded SlowListenerOptions::budget.
+struct SlowListenerEvent {
+	/// @brief Key the listener was registered with.
+	std::string zenoh_key;
+	std::chrono::microseconds wall_time{0};
+	std::chrono::microseconds cpu_time{0};
+	/// @brief Invocations over budget since the previous report.
+	uint64_t overruns = 0;
+	/// @brief True once the listener runs on the dedicated executor.
+	bool isolated = false;
+};
+
+struct SlowListenerOptions {
+	/// @brief Wall time a single listener invocation may take. Empty
+	///        disables the detector.
+	std::optional<std::chrono::microseconds> budget;
+
+	/// @brief Minimum time between two reports about the same listener.
+	std::chrono::milliseconds report_interval{10000};
+
+	/// @brief Called, rate limited, when a listener exceeds the budget.
+	///        A warning is logged instead if empty.
+	///
+	/// Runs on the thread that invoked the listener, so it must be quick.
+	std::function<void(const SlowListenerEvent&)> on_slow_listener;
+
+	/// @brief Move a listener to a dedicated executor thread once it has
+	///        exceeded the budget this many times. Zero never moves it.
+	///
+	/// Isolated listeners no longer hold up zenoh's callback threads, and
+	/// so the other topics. Their messages are queued and delivered in
+	/// order on the executor.
+	uint64_t isolate_after = 0;
+
+	/// @brief Messages queued for isolated listeners beyond this are
+	///        dropped.
+	size_t isolated_queue_capacity = 1024;
+};
+
+/// @brief Timing of one listener.
+struct ListenerStats {
+	std::string zenoh_key;
+	uint64_t invocations = 0;
+	uint64_t overruns = 0;
+	LatencyHistogram wall_time;
+	LatencyHistogram cpu_time;
+	bool isolated = false;
+	/// @brief Messages dropped because the isolated queue was full.
+	uint64_t dropped = 0;
+};
+
+/// @brief Measures listener invocations against a time budget, reports
+///        listeners that exceed it, and optionally moves them off zenoh's
+///        callback threads.
+class SlowListenerDetector {
+public:
+	/// @brief State of one registered listener.
+	class Monitor {
+	public:
+		Monitor(SlowListenerDetector& detector, std::string zenoh_key);
+
+		[[nodiscard]] bool isolated() const {
+			return isolated_.load(std::memory_order_relaxed);
+		}
+
+		/// @brief Stop running calls queued for this listener on the
+		///        executor. Returns once a call in progress there, if any,
+		///        has finished, unless called from that call.
+		void retire();
+
+	private:
+		friend class SlowListenerDetector;
+
+		SlowListenerDetector& detector_;
+		std::atomic<bool> retired_{false};
+		std::mutex mutex_;
+		ListenerStats stats_;
+		uint64_t unreported_overruns_ = 0;
+		std::chrono::steady_clock::time_point last_report_;
+		std::atomic<bool> isolated_{false};
+	};
+
+	explicit SlowListenerDetector(SlowListenerOptions options);
+	~SlowListenerDetector();
+
+	SlowListenerDetector(const SlowListenerDetector&) = delete;
+	SlowListenerDetector& operator=(const SlowListenerDetector&) = delete;
+
+	/// @brief Start monitoring a listener registered with zenoh_key.
+	///        Monitoring stops when the returned pointer is released.
+	std::shared_ptr<Monitor> monitor(std::string zenoh_key);
+
+	/// @brief Run call, a listener invocation, on the calling thread and
+	///        record how long it took.
+	template <typename Call>
+	void measure(Monitor& monitor, Call&& call) {
+		auto wall_start = std::chrono::steady_clock::now();
+		auto cpu_start = threadCpuTime();
+		std::forward<Call>(call)();
+		record(monitor, std::chrono::steady_clock::now() - wall_start,
+		       threadCpuTime() - cpu_start);
+	}
+
+	/// @brief Queue call for the dedicated executor. For monitors that
+	///        are isolated().
+	void post(const std::shared_ptr<Monitor>& monitor,
+	          std::function<void()>&& call);
+
+	/// @brief Timing of every monitored listener.
+	[[nodiscard]] std::vector<ListenerStats> stats() const;
+
+private:
+	static std::chrono::nanoseconds threadCpuTime() {
+		timespec now{};
+		::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+		return std::chrono::seconds(now.tv_sec) +
+		       std::chrono::nanoseconds(now.tv_nsec);
+	}
+
+	void record(Monitor& monitor, std::chrono::nanoseconds wall,
+	            std::chrono::nanoseconds cpu);
+
+	void runExecutor();
+
+	const SlowListenerOptions options_;
+
+	mutable std::mutex monitors_mutex_;
+	std::vector<std::weak_ptr<Monitor>> monitors_;
+
+	struct Task {
+		std::shared_ptr<Monitor> monitor;
+		std::function<void()> call;
+	};
+
+	std::mutex executor_mutex_;
+	std::condition_variable executor_cv_;
+	std::deque<Task> executor_queue_;
+	/// @brief Monitor of the call the executor is running, if any.
+	const Monitor* running_ = nullptr;
+	std::condition_variable running_done_;
+	bool stopping_ = false;
+	/// @brief Started with the first isolated listener.
+	std::thread executor_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_SLOWLISTENERDETECTOR_H
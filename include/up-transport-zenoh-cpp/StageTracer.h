@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_STAGETRACER_H
+#define UP_TRANSPORT_ZENOH_CPP_STAGETRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "PerThread.h"
+
+namespace uprotocol::transport {
+
+/// @brief Records how long each stage of sending and receiving a message
+///        takes, for export as a Chrome trace.
+///
+/// Each thread records into its own fixed-size ring buffer, overwriting
+/// its oldest events when full. Recording takes no lock and never blocks
+/// the thread dumping the trace.
+class StageTracer {
+public:
+	/// @brief Times a stage from construction to destruction.
+	///
+	/// Does nothing but a null check when given a null tracer, so that
+	/// spans can stay in place when tracing is disabled.
+	class Span {
+	public:
+		/// @param category Static string, e.g. "send".
+		/// @param name Static string naming the stage.
+		Span(StageTracer* tracer, const char* category, const char* name)
+		    : tracer_(tracer), category_(category), name_(name) {
+			if (tracer_ != nullptr) {
+				start_ = now();
+			}
+		}
+
+		~Span() {
+			if (tracer_ != nullptr) {
+				tracer_->record(category_, name_, start_, now());
+			}
+		}
+
+		Span(const Span&) = delete;
+		Span& operator=(const Span&) = delete;
+
+	private:
+		StageTracer* tracer_;
+		const char* category_;
+		const char* name_;
+		int64_t start_ = 0;
+	};
+
+	/// @param events_per_thread Capacity of each thread's ring buffer.
+	explicit StageTracer(size_t events_per_thread);
+
+	/// @brief Record a completed stage in the calling thread's buffer.
+	///
+	/// @param start_ns Start time from now().
+	/// @param end_ns End time from now().
+	void record(const char* category, const char* name, int64_t start_ns,
+	            int64_t end_ns);
+
+	/// @brief Write every buffered event in Chrome trace event format, for
+	///        chrome://tracing or https://ui.perfetto.dev.
+	void dumpChromeTrace(std::ostream& out) const;
+
+	/// @brief Steady clock, in nanoseconds.
+	static int64_t now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		           std::chrono::steady_clock::now().time_since_epoch())
+		    .count();
+	}
+
+private:
+	/// @brief Slot of a ring buffer, guarded by a sequence lock so that the
+	///        dumping thread can detect slots being overwritten.
+	struct Slot {
+		/// @brief Odd while being written.
+		std::atomic<uint64_t> sequence{0};
+		std::atomic<const char*> category{nullptr};
+		std::atomic<const char*> name{nullptr};
+		std::atomic<int64_t> start_ns{0};
+		std::atomic<int64_t> duration_ns{0};
+	};
+
+	struct Ring {
+		explicit Ring(size_t capacity);
+
+		std::vector<Slot> slots;
+		/// @brief Number of events ever recorded. Only written by the
+		///        owning thread.
+		std::atomic<uint64_t> recorded{0};
+		/// @brief Kernel thread id, so that traces line up with perf.
+		const int64_t tid;
+	};
+
+	const size_t events_per_thread_;
+	PerThread<Ring> rings_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_STAGETRACER_H
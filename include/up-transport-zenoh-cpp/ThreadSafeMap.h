@@ -2,6 +2,8 @@
 #include <map>
 #include <mutex>
 #include <optional>
+#include <utility>
+#include <vector>
 
 template <typename Key, typename Value>
 class ThreadSafeMap {
@@ -15,11 +17,27 @@ public:
 		return map_.emplace(std::forward<Args>(args)...);
 	}
 
+	void emplace_all(std::vector<std::pair<Key, Value>>&& entries) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (auto& [key, value] : entries) {
+			map_.emplace(std::move(key), std::move(value));
+		}
+	}
+
 	size_t erase(const Key& key) {
 		std::lock_guard<std::mutex> lock(mutex_);
 		return map_.erase(key);
 	}
 
+	std::optional<Value> extract(const Key& key) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto node = map_.extract(key);
+		if (node.empty()) {
+			return std::nullopt;
+		}
+		return std::move(node.mapped());
+	}
+
 	std::optional<Value> find(const Key& key) {
 		std::lock_guard<std::mutex> lock(mutex_);
 		Iterator it = map_.find(key);
@@ -30,6 +48,17 @@ public:
 		}
 	}
 
+	template <typename Function>
+	bool update(const Key& key, Function function) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		Iterator it = map_.find(key);
+		if (it == map_.end()) {
+			return false;
+		}
+		function(it->second);
+		return true;
+	}
+
 	template <typename Predicate>
 	std::optional<Value> find_if(Predicate pred) {
 		std::lock_guard<std::mutex> lock(mutex_);
@@ -41,6 +70,14 @@ public:
 		}
 	}
 
+	template <typename Function>
+	void for_each(Function function) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (auto& [key, value] : map_) {
+			function(key, value);
+		}
+	}
+
 private:
 	MapType map_;
 	mutable std::mutex mutex_;
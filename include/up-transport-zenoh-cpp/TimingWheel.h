@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_TIMINGWHEEL_H
+#define UP_TRANSPORT_ZENOH_CPP_TIMINGWHEEL_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace uprotocol::transport {
+
+/// @brief Deadlines for many keys, with constant time insertion and removal.
+///
+/// A hashed hierarchical timing wheel: four wheels of 256 slots each, the
+/// first advancing one slot per tick and every other one slot per turn of
+/// the wheel below it. An entry sits in the slot of its expiry tick on the
+/// lowest wheel whose range covers it, and moves down a wheel when that
+/// slot comes up. Deadlines are rounded up to the next tick.
+///
+/// Not thread safe.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class TimingWheel {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit TimingWheel(Clock::duration tick,
+	                     Clock::time_point start = Clock::now())
+	    : tick_(tick), start_(start) {}
+
+	/// @returns false if the key already had a deadline.
+	bool insert(const Key& key, Value value, Clock::time_point deadline) {
+		auto [found, inserted] = entries_.try_emplace(key);
+		if (!inserted) {
+			return false;
+		}
+		auto& entry = found->second;
+		entry.value = std::move(value);
+		entry.expiry = deadline <= start_ ? 0 : ticksUntil(deadline, true);
+		place(*found, current_ + 1);
+		return true;
+	}
+
+	/// @returns The value of the removed entry, or std::nullopt if the key
+	///          had no deadline.
+	std::optional<Value> erase(const Key& key) {
+		auto found = entries_.find(key);
+		if (found == entries_.end()) {
+			return std::nullopt;
+		}
+		unlink(*found);
+		auto value = std::move(found->second.value);
+		entries_.erase(found);
+		return value;
+	}
+
+	/// @brief Move up to now, appending the entries that expired to
+	///        expired.
+	void advance(Clock::time_point now,
+	             std::vector<std::pair<Key, Value>>& expired) {
+		uint64_t target = now <= start_ ? 0 : ticksUntil(now, false);
+		while (current_ < target && !entries_.empty()) {
+			++current_;
+			// Higher wheels first, as they cascade into the lower ones.
+			for (size_t level = LEVELS - 1; level > 0; --level) {
+				if ((current_ & levelMask(level)) != 0) {
+					continue;
+				}
+				auto& slot = slots_[slotIndex(level, current_)];
+				auto cascading = std::move(slot);
+				slot.clear();
+				for (auto* node : cascading) {
+					place(*node, current_);
+				}
+			}
+
+			auto& due = slots_[slotIndex(0, current_)];
+			for (auto* node : due) {
+				expired.emplace_back(node->first,
+				                     std::move(node->second.value));
+				entries_.erase(entries_.find(node->first));
+			}
+			due.clear();
+		}
+		// Nothing left to expire on the way.
+		current_ = std::max(current_, target);
+	}
+
+	/// @brief Time of the next tick, the earliest at which advance() can
+	///        expire anything.
+	[[nodiscard]] Clock::time_point nextTick() const {
+		return start_ + tick_ * static_cast<Clock::rep>(current_ + 1);
+	}
+
+	[[nodiscard]] size_t size() const { return entries_.size(); }
+	[[nodiscard]] bool empty() const { return entries_.empty(); }
+
+private:
+	static constexpr size_t SLOT_BITS = 8;
+	static constexpr size_t SLOTS = size_t{1} << SLOT_BITS;
+	static constexpr size_t LEVELS = 4;
+
+	struct Entry {
+		Value value{};
+		/// @brief Tick at which the entry expires.
+		uint64_t expiry = 0;
+		size_t slot = 0;
+		/// @brief Index in slots_[slot].
+		size_t position = 0;
+	};
+
+	using Node = typename std::unordered_map<Key, Entry, Hash>::value_type;
+
+	static constexpr uint64_t levelMask(size_t level) {
+		return (uint64_t{1} << (SLOT_BITS * level)) - 1;
+	}
+
+	static size_t slotIndex(size_t level, uint64_t tick) {
+		return level * SLOTS +
+		       static_cast<size_t>((tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+	}
+
+	uint64_t ticksUntil(Clock::time_point time, bool round_up) const {
+		auto elapsed = time - start_;
+		auto ticks = static_cast<uint64_t>(elapsed / tick_);
+		if (round_up && elapsed % tick_ != Clock::duration::zero()) {
+			++ticks;
+		}
+		return ticks;
+	}
+
+	/// @brief File node in a slot, expiring no earlier than earliest.
+	void place(Node& node, uint64_t earliest) {
+		auto& entry = node.second;
+		entry.expiry = std::max(entry.expiry, earliest);
+		uint64_t delta = entry.expiry - current_;
+		size_t level = 0;
+		while (level + 1 < LEVELS && delta > levelMask(level + 1)) {
+			++level;
+		}
+		// Beyond the top wheel, entries go round it until they are in range.
+		entry.slot = slotIndex(level, entry.expiry);
+		entry.position = slots_[entry.slot].size();
+		slots_[entry.slot].push_back(&node);
+	}
+
+	void unlink(Node& node) {
+		auto& slot = slots_[node.second.slot];
+		auto* last = slot.back();
+		slot[node.second.position] = last;
+		last->second.position = node.second.position;
+		slot.pop_back();
+	}
+
+	const Clock::duration tick_;
+	const Clock::time_point start_;
+	/// @brief Last tick advanced to.
+	uint64_t current_ = 0;
+	/// @brief Node addresses stay valid until they are erased.
+	std::unordered_map<Key, Entry, Hash> entries_;
+	std::array<std::vector<Node*>, LEVELS * SLOTS> slots_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_TIMINGWHEEL_H
@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_TRANSPORTMETRICS_H
+#define UP_TRANSPORT_ZENOH_CPP_TRANSPORTMETRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "LatencyHistogram.h"
+#include "PerThread.h"
+
+namespace uprotocol::transport {
+
+/// @brief Totals for one zenoh key.
+struct TopicMetrics {
+	uint64_t messages_sent = 0;
+	uint64_t bytes_sent = 0;
+	/// @brief Sends rejected by zenoh.
+	uint64_t send_failures = 0;
+	uint64_t messages_received = 0;
+	uint64_t bytes_received = 0;
+	/// @brief Received samples dropped because their attributes could not
+	///        be decoded.
+	uint64_t decode_failures = 0;
+	/// @brief Received samples dropped by the listener's AttributeFilter.
+	uint64_t messages_filtered = 0;
+	/// @brief Sends rejected because the message had outlived its TTL.
+	uint64_t expired_sends = 0;
+	/// @brief Received samples dropped because the message had outlived
+	///        its TTL.
+	uint64_t expired_receives = 0;
+	/// @brief Requests rejected by admission control.
+	uint64_t requests_shed = 0;
+	/// @brief Requests dropped by admission control because they expired
+	///        while waiting.
+	uint64_t requests_expired = 0;
+	/// @brief Requests not sent because they joined an identical request
+	///        in flight.
+	uint64_t requests_coalesced = 0;
+	uint64_t listener_invocations = 0;
+	/// @brief Wall time spent in listeners.
+	std::chrono::nanoseconds listener_time{0};
+	/// @brief Time from publication to delivery of received messages.
+	///        Empty unless latency tracking is enabled.
+	LatencyHistogram delivery_latency;
+};
+
+/// @brief TopicMetrics by zenoh key.
+using MetricsSnapshot = std::map<std::string, TopicMetrics>;
+
+/// @brief Per-key message counters that are cheap to update from many
+///        threads.
+///
+/// Every thread updating the counters gets its own shard, so the hot path
+/// never writes to memory shared with another thread: the only writer of a
+/// shard is its thread, and counters are updated with relaxed loads and
+/// stores rather than read-modify-write atomics. Shards are only read, and
+/// summed, by snapshot().
+class TransportMetrics {
+public:
+	/// @brief Counters for one key in one thread's shard. Aligned to a
+	///        cache line so that shards never share one.
+	struct alignas(64) Counters {
+		std::atomic<uint64_t> messages_sent{0};
+		std::atomic<uint64_t> bytes_sent{0};
+		std::atomic<uint64_t> send_failures{0};
+		std::atomic<uint64_t> messages_received{0};
+		std::atomic<uint64_t> bytes_received{0};
+		std::atomic<uint64_t> decode_failures{0};
+		std::atomic<uint64_t> messages_filtered{0};
+		std::atomic<uint64_t> expired_sends{0};
+		std::atomic<uint64_t> expired_receives{0};
+		std::atomic<uint64_t> requests_shed{0};
+		std::atomic<uint64_t> requests_expired{0};
+		std::atomic<uint64_t> requests_coalesced{0};
+		std::atomic<uint64_t> listener_invocations{0};
+		std::atomic<uint64_t> listener_ns{0};
+		/// @brief Null unless latency tracking is enabled.
+		std::unique_ptr<std::array<std::atomic<uint64_t>,
+		                           LatencyHistogram::BUCKET_COUNT>>
+		    latency;
+	};
+
+	/// @brief Increment a counter of the calling thread's shard.
+	static void add(std::atomic<uint64_t>& counter, uint64_t value) {
+		counter.store(counter.load(std::memory_order_relaxed) + value,
+		              std::memory_order_relaxed);
+	}
+
+	/// @brief Record latency histograms per key if track_latency is set.
+	explicit TransportMetrics(bool track_latency = false);
+
+	/// @brief Record a latency into the calling thread's shard. Ignored
+	///        unless latency tracking is enabled.
+	static void recordLatency(Counters& counters,
+	                          std::chrono::microseconds latency) {
+		if (counters.latency) {
+			add((*counters.latency)[LatencyHistogram::bucketFor(latency)], 1);
+		}
+	}
+
+	[[nodiscard]] bool tracksLatency() const { return track_latency_; }
+
+	TransportMetrics(const TransportMetrics&) = delete;
+	TransportMetrics& operator=(const TransportMetrics&) = delete;
+
+	/// @brief Counters for the given key in the calling thread's shard.
+	///
+	/// The returned reference stays valid for the lifetime of this object
+	/// and must only be updated, through add(), by the calling thread.
+	Counters& local(const std::string& zenoh_key);
+
+	/// @brief Sum all shards.
+	[[nodiscard]] MetricsSnapshot snapshot() const;
+
+private:
+	struct alignas(64) Shard {
+		/// @brief Held by the owning thread while inserting a key, and by
+		///        snapshot() while reading. Never contended on the hot path.
+		std::mutex mutex;
+		std::unordered_map<std::string, Counters> counters;
+	};
+
+	const bool track_latency_;
+
+	/// @brief Shards outlive their threads, so counts are not lost when a
+	///        thread exits.
+	PerThread<Shard> shards_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_TRANSPORTMETRICS_H
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_ZENOHCONFIG_H
+#define UP_TRANSPORT_ZENOH_CPP_ZENOHCONFIG_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define ZENOHCXX_ZENOHC
+#include <zenoh.hxx>
+
+namespace uprotocol::transport {
+
+/// @brief Builder for the zenoh session configuration of a transport.
+///
+/// Starts from zenoh's defaults, a JSON5 document in memory, or a JSON5
+/// file, and applies typed overrides on top. Nothing is parsed until a
+/// session is opened, so building a configuration is cheap and hermetic.
+///
+/// @code
+/// auto config = ZenohConfig()
+///                   .mode(ZenohConfig::Mode::Client)
+///                   .connect({"tcp/10.0.0.1:7447"})
+///                   .multicastScouting(false)
+///                   .batchSize(16384);
+/// ZenohUTransport transport(defaultUri, config);
+/// @endcode
+class ZenohConfig {
+public:
+	enum class Mode { Peer, Client, Router };
+
+	/// @brief Start from zenoh's default configuration.
+	ZenohConfig() = default;
+
+	/// @brief Start from a JSON5 configuration file.
+	static ZenohConfig fromFile(const std::filesystem::path& path);
+
+	/// @brief Start from a JSON5 configuration document.
+	static ZenohConfig fromJson5(std::string json5);
+
+	/// @brief Session mode ("mode").
+	ZenohConfig& mode(Mode mode);
+
+	/// @brief Endpoints to connect to ("connect/endpoints").
+	ZenohConfig& connect(const std::vector<std::string>& endpoints);
+
+	/// @brief Endpoints to listen on ("listen/endpoints").
+	ZenohConfig& listen(const std::vector<std::string>& endpoints);
+
+	/// @brief Enable or disable multicast scouting
+	///        ("scouting/multicast/enabled").
+	ZenohConfig& multicastScouting(bool enabled);
+
+	/// @brief Enable or disable gossip scouting
+	///        ("scouting/gossip/enabled").
+	ZenohConfig& gossipScouting(bool enabled);
+
+	/// @brief Maximum size of a batch on the wire
+	///        ("transport/link/tx/batch_size").
+	ZenohConfig& batchSize(uint16_t bytes);
+
+	/// @brief Enable or disable shared memory transport
+	///        ("transport/shared_memory/enabled").
+	ZenohConfig& sharedMemory(bool enabled);
+
+	/// @brief Enable or disable the unicast low-latency transport
+	///        ("transport/unicast/lowlatency").
+	ZenohConfig& lowLatency(bool enabled);
+
+	/// @brief Enable or disable QoS (priorities, reliability) on unicast
+	///        links ("transport/unicast/qos/enabled").
+	ZenohConfig& qos(bool enabled);
+
+	/// @brief Enable or disable batch compression on unicast links
+	///        ("transport/unicast/compression/enabled").
+	ZenohConfig& compression(bool enabled);
+
+	/// @brief Set any other zenoh configuration key.
+	///
+	/// @param key Key path, e.g. "transport/link/tx/lease".
+	/// @param json5_value Value as a JSON5 literal, e.g. "10000".
+	ZenohConfig& set(std::string key, std::string json5_value);
+
+	/// @brief Produce a zenoh::Config with all overrides applied.
+	///
+	/// @throws zenoh::ZException if the base document or an override is
+	///         rejected by zenoh.
+	[[nodiscard]] zenoh::Config build() const;
+
+	/// @brief String that is equal for two builders iff they produce the
+	///        same configuration. Used to key the SessionPool.
+	[[nodiscard]] std::string id() const;
+
+private:
+	enum class Source { Default, File, Json5 };
+
+	Source source_ = Source::Default;
+	/// @brief File path or JSON5 document, depending on source_.
+	std::string base_;
+	std::vector<std::pair<std::string, std::string>> overrides_;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_ZENOHCONFIG_H
@@ -13,16 +13,38 @@
 #define UP_TRANSPORT_ZENOH_CPP_ZENOHUTRANSPORT_H
 
 #include <up-cpp/transport/UTransport.h>
+#include <up-cpp/utils/Expected.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
+#include <iosfwd>
+#include <map>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #define ZENOHCXX_ZENOHC
 #include <zenoh.hxx>
 
+#include "AttributeFilter.h"
+#include "EventFdReceiver.h"
+#include "PullReceiver.h"
+#include "Reaper.h"
+#include "RequestAdmission.h"
+#include "RequestCoalescer.h"
+#include "RequestId.h"
+#include "RpcDeadlineTracker.h"
+#include "RetentionPool.h"
+#include "SessionPool.h"
+#include "SlowListenerDetector.h"
+#include "StageTracer.h"
 #include "ThreadSafeMap.h"
+#include "TransportMetrics.h"
+#include "ZenohConfig.h"
+#include "ZenohUTransportOptions.h"
 
 namespace uprotocol::transport {
 
@@ -50,10 +72,164 @@ struct ZenohUTransport : public UTransport {
 	///                   clients using this transport instance.
 	/// @param configFile Path to a configuration file containing the Zenoh
 	///                   transport configuration.
+	/// @param options (Optional) Transport behavior that is not part of the
+	///                Zenoh configuration.
 	ZenohUTransport(const v1::UUri& defaultUri,
-	                const std::filesystem::path& configFile);
+	                const std::filesystem::path& configFile,
+	                const ZenohUTransportOptions& options = {});
 
-	virtual ~ZenohUTransport() = default;
+	/// @brief Constructor
+	///
+	/// @param defaultUri Default Authority and Entity (as a UUri) for
+	///                   clients using this transport instance.
+	/// @param config Zenoh configuration, either built programmatically or
+	///               from an in-memory JSON5 document with
+	///               ZenohConfig::fromJson5().
+	/// @param options (Optional) Transport behavior that is not part of the
+	///                Zenoh configuration.
+	ZenohUTransport(const v1::UUri& defaultUri, const ZenohConfig& config,
+	                const ZenohUTransportOptions& options = {});
+
+	/// @brief Returns once no subscriber callback uses the transport.
+	///
+	/// Must not be called from one of the transport's listeners.
+	virtual ~ZenohUTransport();
+
+	/// @brief Declare the publishers and subscribers listed in a manifest.
+	///
+	/// All declarations run concurrently in one warm-up phase, so that the
+	/// first messages sent or received later do not pay declaration
+	/// latency. Listeners later registered with a manifest filter take over
+	/// its pre-declared subscriber, and messages sent with a manifest
+	/// source, sink and priority go through its pre-declared publisher.
+	///
+	/// @returns How long the warm-up took and what was declared.
+	WarmUpReport declareManifest(const DeclarationManifest& manifest);
+
+	/// @brief Report of the warm-up run for ZenohUTransportOptions::manifest
+	///        during construction. Empty if no manifest was given.
+	[[nodiscard]] const WarmUpReport& warmUpReport() const {
+		return warm_up_report_;
+	}
+
+	/// @brief Per-key message counters, summed over all threads.
+	///
+	/// Senders are counted under the key of the topic they sent to, and
+	/// listeners under the key they were registered with, which contains
+	/// wildcards if their filter does.
+	///
+	/// @returns The totals since construction, or an empty snapshot if
+	///          ZenohUTransportOptions::metrics is not set.
+	[[nodiscard]] MetricsSnapshot metricsSnapshot() const;
+
+	/// @brief Requests sent that have neither been answered nor expired.
+	///
+	/// @returns Zero unless ZenohUTransportOptions::rpc_deadlines is set.
+	[[nodiscard]] size_t pendingRequests() const;
+
+	/// @brief Write the stages recorded since construction, up to
+	///        ZenohUTransportOptions::trace_events_per_thread per thread,
+	///        as Chrome trace JSON.
+	///
+	/// Sends are traced through sendImpl, toZenohKeyString,
+	/// sendPublishNotification_, uattributesToAttachment and put; received
+	/// messages through on_sample, sampleToUMessage and listener. Writes
+	/// an empty trace if tracing is disabled.
+	void dumpTrace(std::ostream& out) const;
+
+	/// @brief Wall and CPU time of every registered listener.
+	///
+	/// @returns One entry per listener, or none if
+	///          ZenohUTransportOptions::slow_listeners has no budget.
+	[[nodiscard]] std::vector<ListenerStats> listenerStats() const;
+
+	/// @brief Reuse of idle subscribers kept by
+	///        ZenohUTransportOptions::retention. All zero if disabled.
+	[[nodiscard]] RetentionStats retentionStats() const;
+
+	/// @brief One listener for registerListeners().
+	struct ListenerRegistration {
+		v1::UUri source_filter;
+		ListenCallback listener;
+		std::optional<v1::UUri> sink_filter;
+	};
+
+	/// @brief Register many listeners at once.
+	///
+	/// Equivalent to calling registerListener() for each entry, but the
+	/// subscribers that have to be declared are declared concurrently, and
+	/// all registrations are recorded under a single lock. Intended for
+	/// gateways and bridges registering thousands of filters at startup.
+	///
+	/// @returns One result per entry, in the same order. A failed entry
+	///          does not affect the others.
+	[[nodiscard]] std::vector<utils::Expected<ListenHandle, v1::UStatus>>
+	registerListeners(std::vector<ListenerRegistration>&& registrations);
+
+	/// @brief Register a listener that only receives messages whose
+	///        attributes also pass an AttributeFilter.
+	///
+	/// The filter is checked in the subscriber callback against fields
+	/// read straight from the attachment bytes, so rejected messages are
+	/// never decoded and their payload is never copied. They are counted
+	/// in TopicMetrics::messages_filtered.
+	///
+	/// @param source_filter UUri for filtering messages by source address.
+	/// @param listener Callback for every message passing all filters.
+	/// @param filter Conditions on the message type, priority and source
+	///               authority.
+	/// @param sink_filter (Optional) UUri for filtering messages by sink
+	///                    address.
+	///
+	/// @returns * A handle removing the registration when destroyed if the
+	///            registration succeeded.
+	///          * FAILSTATUS with the appropriate failure otherwise.
+	[[nodiscard]] utils::Expected<ListenHandle, v1::UStatus>
+	registerFilteredListener(const v1::UUri& source_filter,
+	                         ListenCallback&& listener,
+	                         const AttributeFilter& filter,
+	                         std::optional<v1::UUri>&& sink_filter = {});
+
+	/// @brief Register a pull-based listener for the given filters.
+	///
+	/// Instead of invoking a callback on zenoh's threads, matching messages
+	/// are buffered in a bounded FIFO or ring PullReceiver::Queue. The
+	/// caller drains them in bulk from the returned handle on a thread of
+	/// its choosing. Messages are counted and traced when received, and
+	/// expired ones dropped, as for callback listeners.
+	///
+	/// @param source_filter UUri for filtering messages by source address.
+	/// @param sink_filter (Optional) UUri for filtering messages by sink
+	///                    address.
+	/// @param options Behavior of the queue when full, and its capacity.
+	///
+	/// @returns * A PullReceiver if the registration succeeded. The
+	///            registration is removed when the handle is destroyed.
+	///          * FAILSTATUS with the appropriate failure otherwise.
+	[[nodiscard]] utils::Expected<PullReceiver, v1::UStatus>
+	registerPullListener(const v1::UUri& source_filter,
+	                     std::optional<v1::UUri>&& sink_filter = {},
+	                     const PullReceiverOptions& options = {});
+
+	/// @brief Register a listener whose messages are queued and signalled
+	///        through an eventfd.
+	///
+	/// Intended for single-threaded reactors: the returned handle exposes a
+	/// non-blocking file descriptor to add to an epoll set, and messages are
+	/// drained from it on the reactor's own thread.
+	///
+	/// @param source_filter UUri for filtering messages by source address.
+	/// @param sink_filter (Optional) UUri for filtering messages by sink
+	///                    address.
+	/// @param options Queue capacity, and what to drop when it is full.
+	///
+	/// @returns * An EventFdReceiver if the registration succeeded. The
+	///            registration is removed when the handle is destroyed.
+	///          * FAILSTATUS with the appropriate failure otherwise.
+	[[nodiscard]] utils::Expected<EventFdReceiver, v1::UStatus>
+	registerEventFdListener(const v1::UUri& source_filter,
+	                        std::optional<v1::UUri>&& sink_filter = {},
+	                        const EventFdReceiverOptions& options = {});
 
 protected:
 	/// @brief Send a message.
@@ -99,30 +275,446 @@ protected:
 	    const std::string& default_authority_name, const v1::UUri& source,
 	    const std::optional<v1::UUri>& sink);
 
+	/// @param compact Leave out the source and sink, which the receiver
+	///                takes from the zenoh key instead.
+	static std::vector<std::pair<std::string, std::string>>
+	uattributesToAttachment(const v1::UAttributes& attributes,
+	                        bool compact = false);
+
+	/// @param zenoh_key Key the attachment was received on, providing the
+	///                  source and sink of compact attachments.
+	///
+	/// @returns std::nullopt if the attachment is malformed.
+	static std::optional<v1::UAttributes> attachmentToUAttributes(
+	    const zenoh::Bytes& attachment, std::string_view zenoh_key);
+
+	/// @brief Source and sink encoded in a zenoh key.
+	struct KeyUUris {
+		v1::UUri source;
+		/// @brief Empty for keys of publish messages.
+		std::optional<v1::UUri> sink;
+	};
+
+	/// @brief Inverse of toZenohKeyString().
+	///
+	/// Splits the key in one pass and decodes the hex ids through a lookup
+	/// table, without any protobuf parsing. Wildcard segments map back to
+	/// the wildcard ids. Authorities are returned as found in the key, i.e.
+	/// with the default authority filled in.
+	///
+	/// @returns std::nullopt if the key is not in the format written by
+	///          toZenohKeyString().
+	static std::optional<KeyUUris> fromZenohKeyString(
+	    std::string_view zenoh_key);
+
+	/// @brief Append the zenoh key for source and sink to out, without
+	///        allocating beyond out's capacity.
+	static void appendZenohKey(std::string& out,
+	                           const std::string& default_authority_name,
+	                           const v1::UUri& source,
+	                           const std::optional<v1::UUri>& sink);
+
 private:
+	friend class PullReceiver;
+
+	/// @brief Lets subscriber callbacks use the transport until it is
+	///        closed.
+	///
+	/// zenoh may still run a callback it picked up before the subscriber
+	/// was undeclared, so callbacks hold on to the gate rather than rely on
+	/// the transport being alive.
+	struct CallbackGate {
+		/// @brief Held by a callback for as long as it uses the transport.
+		class Pass {
+		public:
+			explicit Pass(CallbackGate& gate);
+			~Pass();
+
+			Pass(const Pass&) = delete;
+			Pass& operator=(const Pass&) = delete;
+
+			/// @brief False once the gate is closed, in which case the
+			///        callback must not use the transport.
+			explicit operator bool() const { return entered_; }
+
+		private:
+			void leave();
+
+			CallbackGate& gate_;
+			bool entered_;
+		};
+
+		/// @brief Turn away later callbacks, and return once those holding
+		///        a Pass have finished.
+		void close();
+
+		std::atomic<size_t> in_flight{0};
+		std::atomic<bool> closed{false};
+		std::mutex mutex;
+		std::condition_variable idle;
+	};
+
+	/// @brief Indirection between a subscriber callback and the listener it
+	///        delivers to, allowing the subscriber to be declared before,
+	///        and kept after, the listener it serves.
+	struct ListenerSlot {
+		struct Target {
+			CallableConn listener;
+			/// @brief Null unless slow listener detection is enabled.
+			std::shared_ptr<SlowListenerDetector::Monitor> monitor;
+			/// @brief Null if the listener takes every message.
+			std::shared_ptr<const CompiledAttributeFilter> filter;
+			/// @brief Set if the listener's sink filter names a method, so
+			///        that requests to it go through request admission.
+			bool method_server = false;
+			/// @brief Numbers the target within the slot; set by attach().
+			uint64_t attachment = 0;
+		};
+
+		void attach(Target target);
+
+		/// @brief Stop delivering to the attached target.
+		///
+		/// Returns once deliveries in progress on other threads have
+		/// finished, so that the listener is never called afterwards. A
+		/// listener may detach its own slot.
+		void detach();
+
+		/// @brief Call deliver with a copy of the attached target, if any,
+		///        and if it is the given attachment when one is given.
+		template <typename Deliver>
+		void deliver(Deliver&& deliver,
+		             std::optional<uint64_t> attachment = std::nullopt);
+
+		/// @brief Which subscriber delivers to the slot.
+		enum class Route : uint8_t {
+			/// @brief The slot's own subscriber.
+			Own,
+			/// @brief Both the own subscriber and an AggregateGroup's,
+			///        until the group's delivers its first sample.
+			Handover,
+			/// @brief The AggregateGroup's subscriber. The own subscriber
+			///        drops its samples until it is undeclared.
+			Aggregate
+		};
+
+		std::mutex mutex;
+		std::condition_variable idle;
+		std::optional<Target> target;
+		/// @brief Deliveries in progress.
+		size_t in_flight = 0;
+		/// @brief Targets attached so far.
+		uint64_t attachments = 0;
+		/// @brief Written with mutex held.
+		std::atomic<Route> route{Route::Own};
+		/// @brief Ids of the messages the own subscriber delivered during
+		///        the handover, which the group's subscriber then skips.
+		std::unordered_set<RequestId, RequestIdHash> handed_over;
+	};
+
+	struct DeclaredPublisher {
+		zenoh::Priority priority;
+		zenoh::Publisher publisher;
+	};
+
+	/// @brief Subscriber delivering through a ListenerSlot.
+	struct SlotSubscriber {
+		std::shared_ptr<ListenerSlot> slot;
+		zenoh::Subscriber<void> subscriber;
+	};
+
+	/// @brief Listeners whose filters differ only in the source resource
+	///        id, and whose subscribers are on the same session. See
+	///        SubscriptionAggregationOptions.
+	struct AggregateGroup {
+		struct Member {
+			CallableConn listener;
+			uint32_t resource_id;
+			std::string zenoh_key;
+			std::shared_ptr<ListenerSlot> slot;
+		};
+
+		AggregateGroup(std::string key, size_t key_shard)
+		    : zenoh_key(std::move(key)), shard(key_shard) {}
+
+		/// @brief Wildcard key of the group's subscriber.
+		const std::string zenoh_key;
+		/// @brief Shard of the members' keys, on whose session the group's
+		///        subscriber is declared.
+		const size_t shard;
+
+		std::mutex mutex;
+		std::map<CallableConn, std::shared_ptr<Member>> members;
+		/// @brief Members served by the group, by resource id.
+		std::unordered_multimap<uint32_t, std::shared_ptr<Member>>
+		    by_resource;
+		/// @brief Set while the group's subscriber is declared, which
+		///        happens without the group's lock held.
+		bool declaring = false;
+		/// @brief Declared once the group reaches the threshold.
+		std::optional<zenoh::Subscriber<void>> subscriber;
+	};
+
+	struct RegisteredSubscriber {
+		std::string zenoh_key;
+		std::shared_ptr<ListenerSlot> slot;
+		/// @brief Empty once the listener is served by an AggregateGroup.
+		std::optional<zenoh::Subscriber<void>> subscriber;
+		/// @brief AggregateGroup counting this listener, if any.
+		std::shared_ptr<AggregateGroup> aggregate;
+	};
+
 	static v1::UStatus uError(v1::UCode code, std::string_view message);
 
-	static std::vector<std::pair<std::string, std::string>>
-	uattributesToAttachment(const v1::UAttributes& attributes);
+	/// @brief Serialized UAttributes taken from an attachment.
+	struct AttachmentAttributes {
+		std::string serialized;
+		/// @brief Source and sink are left out, and taken from the key.
+		bool compact;
+	};
 
-	static v1::UAttributes attachmentToUAttributes(
+	/// @returns std::nullopt if the attachment is malformed.
+	static std::optional<AttachmentAttributes> splitAttachment(
 	    const zenoh::Bytes& attachment);
 
+	/// @returns std::nullopt if the attributes are malformed.
+	static std::optional<v1::UAttributes> parseAttachment(
+	    const AttachmentAttributes& attachment, std::string_view zenoh_key);
+
 	static zenoh::Priority mapZenohPriority(v1::UPriority upriority);
 
-	static v1::UMessage sampleToUMessage(const zenoh::Sample& sample);
-	static v1::UMessage queryToUMessage(const zenoh::Query& query);
+	static std::optional<v1::UMessage> sampleToUMessage(
+	    const zenoh::Sample& sample);
+	static std::optional<v1::UMessage> sampleToUMessage(
+	    const zenoh::Sample& sample, const AttachmentAttributes& attachment);
+	static std::optional<v1::UMessage> queryToUMessage(
+	    const zenoh::Query& query);
+
+	static std::vector<std::shared_ptr<zenoh::Session>> openSessions(
+	    const ZenohConfig& config, const ZenohUTransportOptions& options);
+
+	/// @brief Index of the session carrying the given key within its lane.
+	size_t shardFor(const std::string& zenoh_key) const;
+
+	/// @brief Session that carries traffic for the given key at the given
+	///        zenoh priority.
+	const zenoh::Session& sessionFor(
+	    const std::string& zenoh_key,
+	    zenoh::Priority priority = Z_PRIORITY_DATA) const;
+
+	/// @brief Common part of registerListenerImpl() and
+	///        registerFilteredListener().
+	v1::UStatus registerListener_(
+	    CallableConn listener, const v1::UUri& source_filter,
+	    const std::optional<v1::UUri>& sink_filter,
+	    std::shared_ptr<const CompiledAttributeFilter> filter);
 
 	v1::UStatus registerPublishNotificationListener_(
-	    const std::string& zenoh_key, CallableConn listener);
+	    const std::string& zenoh_key, CallableConn listener,
+	    std::shared_ptr<const CompiledAttributeFilter> filter = nullptr);
+
+	/// @brief Connect a callback the way UTransport::registerListener()
+	///        does, so that dropping the handle calls cleanupListener().
+	std::pair<ListenHandle, CallableConn> connectListener(
+	    ListenCallback&& listener);
+
+	/// @brief True if a listener for source_filter is registered through
+	///        an AggregateGroup.
+	bool isAggregatable(const v1::UUri& source_filter) const;
+
+	/// @brief Subscriber for zenoh_key left idle by the manifest or by an
+	///        earlier listener, if there is one.
+	std::optional<SlotSubscriber> takeIdleSubscriber(
+	    const std::string& zenoh_key);
+
+	/// @brief Attach a listener to an idle subscriber's slot.
+	///
+	/// @returns The entry to add to subscriber_map_.
+	RegisteredSubscriber attachListener(
+	    const std::string& zenoh_key, const CallableConn& listener,
+	    SlotSubscriber&& idle,
+	    std::shared_ptr<const CompiledAttributeFilter> filter);
+
+	/// @brief Register a listener whose filter may be aggregated with
+	///        others that differ only in the source resource id.
+	v1::UStatus registerAggregatableListener_(
+	    const std::string& zenoh_key, const v1::UUri& source_filter,
+	    const std::optional<v1::UUri>& sink_filter, CallableConn listener,
+	    std::shared_ptr<const CompiledAttributeFilter> filter);
+
+	/// @brief Declare a group's wildcard subscriber and hand its members
+	///        over to it. Called without any lock held, by the caller that
+	///        set the group's declaring flag.
+	void aggregate(const std::shared_ptr<AggregateGroup>& group);
+
+	/// @brief Start serving a member from its group's subscriber. Called
+	///        with the group's mutex held, once the subscriber is declared.
+	void handOver(AggregateGroup& group,
+	              const std::shared_ptr<AggregateGroup::Member>& member);
+
+	/// @brief Called by a group's subscriber with the first sample for a
+	///        member still in handover. Undeclares the member's own
+	///        subscriber.
+	///
+	/// @returns False if the own subscriber already delivered the sample.
+	bool completeHandover(const AggregateGroup::Member& member,
+	                      const zenoh::Sample& sample);
+
+	/// @brief Remove a listener from its group, undeclaring the group's
+	///        subscriber with its last member.
+	void leaveAggregate(const std::shared_ptr<AggregateGroup>& group,
+	                    const CallableConn& listener);
+
+	/// @brief Id of the message in a sample, if its attachment scans.
+	static std::optional<RequestId> messageId(const zenoh::Sample& sample);
+
+	/// @brief Settle the request a received response answers: end its RPC
+	///        deadline and its coalesced flight, and deliver a copy of the
+	///        response for each request that joined the flight.
+	///
+	/// Called first by every subscriber, before any filtering, so that
+	/// flights land whichever path receives their response. Only the first
+	/// call for a response finds followers.
+	void settleResponse(const zenoh::Sample& sample);
+
+	/// @brief Deliver copies of a response to every listener whose key
+	///        includes the response's key, as the response itself is.
+	void deliverCopies(const zenoh::Sample& sample,
+	                   const ScannedAttributes& scanned,
+	                   const std::vector<v1::UMessage>& copies);
+
+	/// @brief Count a sample received for zenoh_key.
+	///
+	/// @returns The key's counters, or null if metrics are disabled.
+	TransportMetrics::Counters* countReceived(const std::string& zenoh_key,
+	                                          const zenoh::Sample& sample);
+
+	/// @brief Decode a sample received for zenoh_key and pass it to the
+	///        target's listener, filtering it, updating metrics and
+	///        monitoring the listener if enabled.
+	void deliverSample(const std::string& zenoh_key,
+	                   const std::shared_ptr<ListenerSlot>& slot,
+	                   ListenerSlot::Target& target,
+	                   const zenoh::Sample& sample);
+
+	/// @brief Pass a message decoded by deliverSample() to the target's
+	///        listener, or to request admission.
+	void dispatchMessage(const std::string& zenoh_key,
+	                     const std::shared_ptr<ListenerSlot>& slot,
+	                     ListenerSlot::Target& target,
+	                     const zenoh::Sample& sample,
+	                     TransportMetrics::Counters* counters,
+	                     v1::UMessage&& message);
+
+	/// @brief Call the target's listener, or post it to the executor of
+	///        isolated listeners, timing it if counters are given.
+	void invokeListener(ListenerSlot::Target& target,
+	                    TransportMetrics::Counters* counters,
+	                    v1::UMessage&& message);
+
+	/// @brief Declare a subscriber for zenoh_key with no listener yet.
+	///
+	/// @throws zenoh::ZException if the declaration fails.
+	SlotSubscriber declareSlotSubscriber(const std::string& zenoh_key);
+
+	/// @brief Monitor for a new listener, or null if slow listener
+	///        detection is disabled.
+	std::shared_ptr<SlowListenerDetector::Monitor> monitorListener(
+	    const std::string& zenoh_key);
+
+	/// @brief Hand a received request to admission control, which calls
+	///        the target's listener on one of its threads, or rejects the
+	///        request with an error response.
+	///
+	/// The listener is called through its slot, and only while the target
+	/// is still attached to it, so that it is not called once removed.
+	void admitRequest(const std::string& zenoh_key,
+	                  const std::shared_ptr<ListenerSlot>& slot,
+	                  const ListenerSlot::Target& target,
+	                  v1::UMessage&& message);
 
 	v1::UStatus sendPublishNotification_(const std::string& zenoh_key,
 	                                     const std::string& payload,
 	                                     const v1::UAttributes& attributes);
 
-	zenoh::Session session_;
+	/// @brief Lane-major: lane L, shard S is at L * shard_count_ + S.
+	std::vector<std::shared_ptr<zenoh::Session>> sessions_;
+	size_t shard_count_;
+
+	bool compact_attachments_;
+
+	/// @brief Empty unless ZenohUTransportOptions::ttl_enforcement is
+	///        enabled.
+	std::optional<std::chrono::milliseconds> ttl_tolerance_;
+
+	// Shuts subscriber callbacks out before any member they use is
+	// destroyed. Captured by the callbacks, so that it outlives them.
+	std::shared_ptr<CallbackGate> callback_gate_ =
+	    std::make_shared<CallbackGate>();
+
+	/// @brief Null unless ZenohUTransportOptions::metrics is set.
+	std::unique_ptr<TransportMetrics> metrics_;
+
+	/// @brief Null unless ZenohUTransportOptions::trace_events_per_thread
+	///        is set.
+	std::unique_ptr<StageTracer> tracer_;
+
+	/// @brief Null unless ZenohUTransportOptions::slow_listeners has a
+	///        budget.
+	std::unique_ptr<SlowListenerDetector> slow_listeners_;
+
+	/// @brief Null unless ZenohUTransportOptions::request_admission has
+	///        worker threads.
+	std::unique_ptr<RequestAdmission> admission_;
+
+	/// @brief Null unless ZenohUTransportOptions::rpc_deadlines is set.
+	std::unique_ptr<RpcDeadlineTracker> rpc_deadlines_;
+
+	/// @brief Null unless ZenohUTransportOptions::request_coalescing lists
+	///        methods.
+	std::unique_ptr<RequestCoalescer> coalescer_;
+
+	/// @brief Undeclares subscribers of removed listeners, off the thread
+	///        removing them.
+	Reaper<zenoh::Subscriber<void>> reaper_;
+
+	/// @brief Null unless ZenohUTransportOptions::retention has a capacity.
+	std::unique_ptr<RetentionPool<SlotSubscriber>> retained_subscribers_;
+
+	/// @brief Zero unless ZenohUTransportOptions::aggregation is set.
+	size_t aggregation_threshold_;
+
+	ThreadSafeMap<CallableConn, RegisteredSubscriber> subscriber_map_;
+
+	/// @brief Queues of pull listeners, by key, which deliverCopies() also
+	///        reaches. Only kept while coalescer_ is set.
+	std::mutex pull_queues_mutex_;
+	std::vector<std::pair<std::string, std::weak_ptr<PullReceiver::Queue>>>
+	    pull_queues_;
+
+	std::mutex aggregation_mutex_;
+	/// @brief Groups by wildcard key and shard.
+	std::map<std::pair<std::string, size_t>, std::shared_ptr<AggregateGroup>>
+	    aggregates_;
+
+	/// @brief Serializes declareManifest(), so that no key is declared
+	///        twice.
+	std::mutex manifest_mutex_;
+
+	/// @brief Publishers declared by declareManifest(), by key.
+	///
+	/// Looked up on every send once any is declared, and only written by
+	/// declareManifest(), so sends take the lock shared. Entries are never
+	/// erased, and references to them stay valid once it is released.
+	std::shared_mutex publishers_mutex_;
+	std::unordered_map<std::string, DeclaredPublisher> publishers_;
+	/// @brief Lets sends skip the publisher lookup when none are declared.
+	std::atomic<bool> has_publishers_{false};
+
+	ThreadSafeMap<std::string, std::shared_ptr<SlotSubscriber>>
+	    predeclared_map_;
 
-	ThreadSafeMap<CallableConn, zenoh::Subscriber<void>> subscriber_map_;
+	WarmUpReport warm_up_report_;
 };
 
 }  // namespace uprotocol::transport
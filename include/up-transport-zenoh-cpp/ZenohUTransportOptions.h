@@ -0,0 +1,289 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UP_TRANSPORT_ZENOH_CPP_ZENOHUTRANSPORTOPTIONS_H
+#define UP_TRANSPORT_ZENOH_CPP_ZENOHUTRANSPORTOPTIONS_H
+
+#include <up-core-api/uuid.pb.h>
+#include <up-core-api/uuri.pb.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DeclarationManifest.h"
+#include "RequestAdmission.h"
+#include "SlowListenerDetector.h"
+
+namespace uprotocol::transport {
+
+/// @brief Session settings for one priority lane. Only used when
+///        ZenohUTransportOptions::priority_lanes is set.
+struct PriorityLaneOptions {
+	/// @brief Overrides transport/link/tx/batch_size for this lane's
+	///        sessions. Small batches favor latency, large ones throughput.
+	std::optional<uint16_t> batch_size;
+
+	/// @brief Additional zenoh configuration overrides for this lane, as
+	///        (key path, JSON5 value) pairs, e.g.
+	///        {"transport/link/tx/queue/congestion_control/wait_before_drop",
+	///         "1000"}.
+	std::vector<std::pair<std::string, std::string>> config_overrides;
+};
+
+/// @brief Sizing and placement of zenoh's runtime threads.
+///
+/// The zenoh runtime is shared by every session in the process and is
+/// created when the first session is opened, so these settings only take
+/// effect for the first transport constructed in the process. Later
+/// transports log a warning if they specify any.
+///
+/// zenoh takes thread counts from the ZENOH_RUNTIME environment variable
+/// only, so unless it was already set, it is set while the sessions are
+/// opened and unset afterwards. Changing the environment races with other
+/// threads reading it, so a transport given thread counts must be
+/// constructed before the process starts other threads. Affinity and
+/// scheduling are applied to the constructing thread while the sessions
+/// are opened, and restored afterwards; the runtime's threads inherit them
+/// when they are spawned.
+/// Pools the runtime only creates later, on first use after the sessions
+/// are open, are spawned from runtime threads or from the thread using
+/// them and are not placed.
+struct RuntimeOptions {
+	/// @brief Worker threads receiving from links.
+	std::optional<size_t> rx_threads;
+	/// @brief Worker threads transmitting on links.
+	std::optional<size_t> tx_threads;
+	/// @brief Worker threads running application-facing tasks.
+	std::optional<size_t> app_threads;
+
+	/// @brief CPUs the runtime's threads may run on. Empty keeps the
+	///        affinity of the constructing thread.
+	std::vector<int> cpu_affinity;
+
+	/// @brief Scheduling policy for the runtime's threads: SCHED_OTHER,
+	///        SCHED_BATCH, SCHED_IDLE, SCHED_FIFO or SCHED_RR. Real-time
+	///        policies need CAP_SYS_NICE. Empty keeps the policy of the
+	///        constructing thread.
+	std::optional<int> sched_policy;
+
+	/// @brief Static priority for sched_policy: 1-99 for SCHED_FIFO and
+	///        SCHED_RR, 0 for the others.
+	int sched_priority = 0;
+};
+
+/// @brief Keeping subscribers declared after their listener is removed.
+///
+/// Removing a listener normally undeclares its subscriber, and registering
+/// the same filter again later pays for a new declaration and for its
+/// propagation through the network. Retained subscribers stay declared,
+/// without a listener, and are handed to the next listener registered with
+/// the same filters. Samples arriving meanwhile are dropped.
+struct SubscriberRetentionOptions {
+	/// @brief Maximum number of idle subscribers kept. The oldest are
+	///        undeclared first. Zero disables retention.
+	size_t capacity = 0;
+
+	/// @brief How long an idle subscriber is kept before it is undeclared.
+	std::chrono::milliseconds grace_period{30000};
+};
+
+/// @brief Collapsing listeners on many resources of one entity into a
+///        single wildcard subscriber.
+///
+/// Every exact filter is normally declared as a zenoh subscriber of its own,
+/// and every declaration is propagated to all peers and routers. Once enough
+/// listeners are registered with filters that differ only in the source
+/// resource id, their subscribers are replaced by one matching any resource
+/// id, and samples are handed to the listeners registered for the resource
+/// id in their key. Samples for resources nobody listens to are then
+/// received and dropped locally. A group stays aggregated until its last
+/// listener is removed.
+///
+/// With several sessions, listeners are only grouped with those whose
+/// subscribers are on the same session, so the threshold applies to each
+/// session separately. Each topic is thus still received on the session it
+/// would use without aggregation, and no sample is lost or delivered twice
+/// while listeners move over to the group's subscriber.
+struct SubscriptionAggregationOptions {
+	/// @brief Listeners differing only in the resource id needed before
+	///        they are aggregated. Zero disables aggregation.
+	size_t threshold = 0;
+};
+
+/// @brief Dropping messages that have outlived their TTL.
+///
+/// A message expires ttl milliseconds after the timestamp of its UUIDv7 id.
+/// Expired messages are rejected by send() with DEADLINE_EXCEEDED before
+/// they are serialized, and received ones are dropped before their payload
+/// is copied, so that stale requests do not take up a server's time.
+/// Messages without a TTL never expire.
+struct TtlEnforcementOptions {
+	bool enabled = false;
+
+	/// @brief Extra time given to every message before it is considered
+	///        expired, to allow for the sender's clock being ahead of ours.
+	std::chrono::milliseconds clock_skew_tolerance{100};
+};
+
+/// @brief A request sent through the transport that was not answered within
+///        its TTL.
+struct ExpiredRequest {
+	v1::UUID id;
+	/// @brief The request's sink.
+	v1::UUri method;
+};
+
+/// @brief Tracking of the deadlines of requests sent through the transport.
+///
+/// Every request sent with a TTL is entered in a timing wheel keyed by its
+/// id, and removed again when a response carrying that id as its request id
+/// is received by one of the transport's listeners. Requests whose TTL runs
+/// out first are reported in batches, once per tick, so that RPC clients
+/// need no timer of their own per call.
+struct RpcDeadlineOptions {
+	/// @brief Called with the requests that expired since the previous
+	///        call, on a thread owned by the transport. Empty disables
+	///        tracking.
+	std::function<void(std::vector<ExpiredRequest>&&)> on_expired;
+
+	/// @brief Resolution of the deadlines. Expiries are reported up to one
+	///        tick late.
+	std::chrono::milliseconds tick{10};
+};
+
+/// @brief Sharing one request between identical concurrent RPC calls.
+///
+/// A request sent to one of the methods while an identical request (same
+/// source, method, payload format and payload) is still waiting for its
+/// response is not sent. Once that response arrives, a copy carrying the
+/// request's own id is delivered for it as well, to every listener,
+/// callback or pull, that the response reaches. Only suitable for methods
+/// without side effects. Requests sharing one that cannot be sent, or is
+/// never answered, are not answered either. Requests without a TTL are
+/// always sent, as nothing would end their wait for a lost response.
+struct RequestCoalescingOptions {
+	/// @brief Methods whose requests are coalesced. Authorities are
+	///        ignored.
+	std::vector<v1::UUri> methods;
+};
+
+/// @brief Transport behavior that is not part of the zenoh configuration.
+///
+/// The defaults reproduce the behavior of a transport constructed without
+/// options.
+struct ZenohUTransportOptions {
+	/// @brief Number of zenoh sessions opened by the transport (per
+	///        priority lane when priority_lanes is set).
+	///
+	/// Every zenoh key is assigned to one session by a stable hash, so all
+	/// traffic for a topic uses the same session and keeps its ordering
+	/// while different topics are serialized and sent in parallel. Every
+	/// session is opened from the same configuration, which therefore must
+	/// not pin listen endpoints that only one session can bind.
+	size_t session_count = 1;
+
+	/// @brief Route each priority band through its own set of sessions.
+	///
+	/// With lanes enabled, messages are sent on separate sessions (and so
+	/// separate links and batches) depending on their priority:
+	///
+	/// * real-time: CS5 and CS6
+	/// * standard:  CS2 to CS4
+	/// * bulk:      CS0, CS1 and unspecified
+	///
+	/// Real-time messages then never queue behind large bulk transfers.
+	/// Ordering is only preserved between messages of the same topic and
+	/// the same band. Listeners are declared on the standard lane.
+	bool priority_lanes = false;
+
+	PriorityLaneOptions realtime_lane;
+	PriorityLaneOptions standard_lane;
+	PriorityLaneOptions bulk_lane;
+
+	/// @brief Share sessions with other instances in this process.
+	///
+	/// Sessions are taken from the process-wide SessionPool, keyed by the
+	/// configuration they are opened with, instead of being opened by each
+	/// instance. Instances sharing a session still have their own default
+	/// URI and listener registrations. A shared session is closed when the
+	/// last instance using it is destroyed.
+	bool share_sessions = false;
+
+	RuntimeOptions runtime;
+
+	/// @brief Leave the source and sink out of sent attachments.
+	///
+	/// Both are already encoded in the zenoh key, and for small messages
+	/// they can make up half of the attachment. Receivers rebuild them from
+	/// the key, with the sender's default authority in place of an empty
+	/// one. Every transport decodes both formats, but transports predating
+	/// this option drop compact messages, so it should only be enabled once
+	/// all receivers understand them.
+	bool compact_attachments = false;
+
+	TtlEnforcementOptions ttl_enforcement;
+
+	/// @brief Limits on the requests handled at once by RPC servers.
+	///
+	/// Rejected and expired requests are counted in TopicMetrics.
+	RequestAdmissionOptions request_admission;
+
+	RpcDeadlineOptions rpc_deadlines;
+
+	RequestCoalescingOptions request_coalescing;
+
+	/// @brief Count messages, bytes, failures and listener time per key.
+	///
+	/// @see ZenohUTransport::metricsSnapshot()
+	bool metrics = false;
+
+	/// @brief Record publish-to-deliver latency per key into
+	///        TopicMetrics::delivery_latency. Implies metrics.
+	///
+	/// The publication time is taken from the zenoh timestamp of the
+	/// sample if it has one, and otherwise from the millisecond timestamp
+	/// of the UUIDv7 message id. Either way it comes from the sender's
+	/// clock, so the result includes any skew between the two clocks.
+	/// Negative latencies are recorded as zero.
+	bool latency_tracking = false;
+
+	/// @brief Capacity of each thread's buffer of traced stages. Zero
+	///        disables tracing.
+	///
+	/// @see ZenohUTransport::dumpTrace()
+	size_t trace_events_per_thread = 0;
+
+	/// @brief Time listener invocations and report, or isolate, listeners
+	///        that take too long.
+	///
+	/// @see ZenohUTransport::listenerStats()
+	SlowListenerOptions slow_listeners;
+
+	/// @see ZenohUTransport::retentionStats()
+	SubscriberRetentionOptions retention;
+
+	SubscriptionAggregationOptions aggregation;
+
+	/// @brief Topics to declare while constructing the transport.
+	///
+	/// @see ZenohUTransport::declareManifest()
+	std::optional<DeclarationManifest> manifest;
+};
+
+}  // namespace uprotocol::transport
+
+#endif  // UP_TRANSPORT_ZENOH_CPP_ZENOHUTRANSPORTOPTIONS_H
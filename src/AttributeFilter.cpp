@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/AttributeFilter.h"
+
+#include <algorithm>
+
+namespace uprotocol::transport {
+
+namespace {
+
+constexpr uint32_t ALL_TYPES = ~uint32_t{0};
+
+// Types outside the mask, which only malformed messages have, map to none.
+uint32_t typeBit(v1::UMessageType type) {
+	auto value = static_cast<int>(type);
+	return value >= 0 && value < 32 ? uint32_t{1} << value : 0;
+}
+
+}  // namespace
+
+CompiledAttributeFilter::CompiledAttributeFilter(const AttributeFilter& filter)
+    : types_(filter.types.empty() ? ALL_TYPES : 0),
+      min_priority_(filter.min_priority),
+      max_priority_(filter.max_priority),
+      authorities_(filter.authorities) {
+	for (auto type : filter.types) {
+		types_ |= typeBit(type);
+	}
+	std::sort(authorities_.begin(), authorities_.end());
+	authorities_.erase(std::unique(authorities_.begin(), authorities_.end()),
+	                   authorities_.end());
+}
+
+bool CompiledAttributeFilter::matches(const ScannedAttributes& attributes,
+                                      std::string_view source_authority) const {
+	if (types_ != ALL_TYPES && (types_ & typeBit(attributes.type)) == 0) {
+		return false;
+	}
+	if (attributes.priority < min_priority_ ||
+	    attributes.priority > max_priority_) {
+		return false;
+	}
+	return authorities_.empty() ||
+	       std::binary_search(authorities_.begin(), authorities_.end(),
+	                          source_authority);
+}
+
+}  // namespace uprotocol::transport
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/EventFdReceiver.h"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+namespace uprotocol::transport {
+
+EventFdReceiver::Queue::Queue(int event_fd,
+                              const EventFdReceiverOptions& options)
+    : fd(event_fd),
+      capacity(std::max<size_t>(options.capacity, 1)),
+      overflow(options.overflow) {}
+
+EventFdReceiver::Queue::~Queue() { ::close(fd); }
+
+void EventFdReceiver::Queue::push(const v1::UMessage& message) {
+	bool was_empty = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (messages.size() >= capacity) {
+			++dropped;
+			if (overflow == EventFdReceiverOptions::Overflow::DropNewest) {
+				return;
+			}
+			messages.pop_front();
+		}
+		was_empty = messages.empty();
+		messages.push_back(message);
+	}
+	// drain() re-arms the descriptor if it leaves messages behind, so it
+	// only needs signalling when the first message is queued.
+	if (was_empty) {
+		::eventfd_write(fd, 1);
+	}
+}
+
+EventFdReceiver::EventFdReceiver(std::shared_ptr<Queue> queue,
+                                 UTransport::ListenHandle&& handle)
+    : queue_(std::move(queue)), handle_(std::move(handle)) {}
+
+size_t EventFdReceiver::drain(std::vector<v1::UMessage>& out, size_t max) {
+	// Reset readiness before taking messages. A push racing with this can
+	// only leave the descriptor readable with nothing new queued, which
+	// costs one empty drain() but never loses a wakeup.
+	eventfd_t ignored;
+	::eventfd_read(queue_->fd, &ignored);
+
+	size_t taken = 0;
+	bool remaining = false;
+	{
+		std::lock_guard<std::mutex> lock(queue_->mutex);
+		auto& messages = queue_->messages;
+		while (taken < max && !messages.empty()) {
+			out.push_back(std::move(messages.front()));
+			messages.pop_front();
+			++taken;
+		}
+		remaining = !messages.empty();
+	}
+
+	if (remaining) {
+		::eventfd_write(queue_->fd, 1);
+	}
+	return taken;
+}
+
+}  // namespace uprotocol::transport
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace uprotocol::transport {
+
+size_t LatencyHistogram::bucketFor(std::chrono::microseconds latency) {
+	constexpr uint64_t max_value = (uint64_t{1} << (MAX_MAGNITUDE + 1)) - 1;
+	auto value = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+	value = std::min(value, max_value);
+
+	// Values below SUB_BUCKET_COUNT get a bucket each.
+	if (value < SUB_BUCKET_COUNT) {
+		return static_cast<size_t>(value);
+	}
+	auto magnitude = static_cast<size_t>(63 - __builtin_clzll(value));
+	auto shift = magnitude - SUB_BUCKET_BITS;
+	return SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT +
+	       static_cast<size_t>(value >> shift) - SUB_BUCKET_COUNT;
+}
+
+std::chrono::microseconds LatencyHistogram::bucketUpperBound(size_t bucket) {
+	if (bucket < SUB_BUCKET_COUNT) {
+		return std::chrono::microseconds(bucket);
+	}
+	auto shift = (bucket - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+	auto sub_bucket = (bucket - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+	uint64_t next = (SUB_BUCKET_COUNT + sub_bucket + 1) << shift;
+	return std::chrono::microseconds(static_cast<int64_t>(next - 1));
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+	for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+		counts_[i] += other.counts_[i];
+	}
+}
+
+uint64_t LatencyHistogram::count() const {
+	uint64_t total = 0;
+	for (auto count : counts_) {
+		total += count;
+	}
+	return total;
+}
+
+std::chrono::microseconds LatencyHistogram::percentile(double fraction) const {
+	auto total = count();
+	if (total == 0) {
+		return std::chrono::microseconds(0);
+	}
+	fraction = std::clamp(fraction, 0.0, 1.0);
+	auto rank = std::max<uint64_t>(
+	    1, static_cast<uint64_t>(
+	           std::ceil(fraction * static_cast<double>(total))));
+
+	uint64_t seen = 0;
+	for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+		seen += counts_[i];
+		if (seen >= rank) {
+			return bucketUpperBound(i);
+		}
+	}
+	return max();
+}
+
+std::chrono::microseconds LatencyHistogram::max() const {
+	for (size_t i = BUCKET_COUNT; i > 0; --i) {
+		if (counts_[i - 1] != 0) {
+			return bucketUpperBound(i - 1);
+		}
+	}
+	return std::chrono::microseconds(0);
+}
+
+}  // namespace uprotocol::transport
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/PullReceiver.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace uprotocol::transport {
+
+PullReceiver::Queue::Queue(const PullReceiverOptions& options)
+    : channel(options.channel),
+      capacity(std::max<size_t>(options.capacity, 1)) {}
+
+void PullReceiver::Queue::push(zenoh::Sample&& sample) {
+	pushEntry(std::move(sample));
+}
+
+void PullReceiver::Queue::push(v1::UMessage&& message) {
+	pushEntry(std::move(message));
+}
+
+template <typename Entry>
+void PullReceiver::Queue::pushEntry(Entry&& entry) {
+	std::unique_lock<std::mutex> lock(mutex);
+	if (channel == PullReceiverOptions::Channel::Fifo) {
+		space.wait(lock,
+		           [this]() { return closed || samples.size() < capacity; });
+	} else if (samples.size() >= capacity) {
+		samples.pop_front();
+	}
+	if (closed) {
+		return;
+	}
+	bool was_empty = samples.empty();
+	samples.emplace_back(std::forward<Entry>(entry));
+	if (was_empty) {
+		ready.notify_one();
+	}
+}
+
+void PullReceiver::Queue::close() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		closed = true;
+	}
+	ready.notify_all();
+	space.notify_all();
+}
+
+PullReceiver::PullReceiver(std::shared_ptr<Queue> queue,
+                           zenoh::Subscriber<void>&& subscriber)
+    : queue_(std::move(queue)), subscriber_(std::move(subscriber)) {}
+
+PullReceiver::~PullReceiver() {
+	if (queue_) {
+		queue_->close();
+	}
+}
+
+PullReceiver& PullReceiver::operator=(PullReceiver&& other) noexcept {
+	if (this != &other) {
+		if (queue_) {
+			queue_->close();
+		}
+		subscriber_ = std::move(other.subscriber_);
+		queue_ = std::move(other.queue_);
+		disconnected_ = other.disconnected_;
+	}
+	return *this;
+}
+
+std::optional<v1::UMessage> PullReceiver::tryRecv() {
+	std::vector<v1::UMessage> out;
+	if (drain(out, 1) == 0) {
+		return std::nullopt;
+	}
+	return std::move(out.front());
+}
+
+size_t PullReceiver::recvMany(std::vector<v1::UMessage>& out, size_t max,
+                              std::chrono::milliseconds timeout) {
+	if (max == 0) {
+		return 0;
+	}
+	if (timeout <= std::chrono::milliseconds::zero()) {
+		return drain(out, max);
+	}
+	return drain(out, max, std::chrono::steady_clock::now() + timeout);
+}
+
+size_t PullReceiver::drain(
+    std::vector<v1::UMessage>& out, size_t max,
+    std::optional<std::chrono::steady_clock::time_point> deadline) {
+	// Samples are moved out under the lock and decoded after releasing it,
+	// so that delivering threads are held up as little as possible.
+	std::vector<std::variant<zenoh::Sample, v1::UMessage>> taken;
+	{
+		std::unique_lock<std::mutex> lock(queue_->mutex);
+		auto& samples = queue_->samples;
+		if (deadline) {
+			queue_->ready.wait_until(lock, *deadline, [this, &samples]() {
+				return !samples.empty() || queue_->closed;
+			});
+		}
+		bool was_full = samples.size() >= queue_->capacity;
+		while (taken.size() < max && !samples.empty()) {
+			taken.push_back(std::move(samples.front()));
+			samples.pop_front();
+		}
+		if (samples.empty() && queue_->closed) {
+			disconnected_ = true;
+		}
+		if (was_full && !taken.empty()) {
+			queue_->space.notify_all();
+		}
+	}
+
+	size_t received = 0;
+	for (auto& entry : taken) {
+		if (auto* message = std::get_if<v1::UMessage>(&entry)) {
+			out.push_back(std::move(*message));
+			++received;
+			continue;
+		}
+		// Malformed samples are dropped, as they are for callback
+		// listeners.
+		if (auto message = ZenohUTransport::sampleToUMessage(
+		        std::get<zenoh::Sample>(entry))) {
+			out.push_back(std::move(*message));
+			++received;
+		}
+	}
+	return received;
+}
+
+}  // namespace uprotocol::transport
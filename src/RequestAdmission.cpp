@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/RequestAdmission.h"
+
+#include <algorithm>
+
+namespace uprotocol::transport {
+
+RequestAdmission::RequestAdmission(RequestAdmissionOptions options)
+    : options_(std::move(options)) {
+	workers_.reserve(options_.worker_threads);
+	for (size_t i = 0; i < options_.worker_threads; ++i) {
+		workers_.emplace_back([this]() { runWorker(); });
+	}
+}
+
+RequestAdmission::~RequestAdmission() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	ready_cv_.notify_all();
+	for (auto& worker : workers_) {
+		worker.join();
+	}
+}
+
+uint64_t RequestAdmission::methodId(const v1::UUri& method) {
+	return (static_cast<uint64_t>(method.ue_id()) << 24) |
+	       (static_cast<uint64_t>(method.ue_version_major() & 0xFF) << 16) |
+	       (method.resource_id() & 0xFFFF);
+}
+
+size_t RequestAdmission::band(v1::UPriority priority) {
+	auto value = static_cast<int>(priority);
+	if (value < 0) {
+		return 0;
+	}
+	return std::min(static_cast<size_t>(value), PRIORITY_BANDS - 1);
+}
+
+void RequestAdmission::submit(const v1::UUri& method, Request&& request) {
+	if (request.deadline &&
+	    std::chrono::system_clock::now() > *request.deadline) {
+		if (request.expire) {
+			request.expire();
+		}
+		return;
+	}
+
+	std::optional<Request> shed;
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		auto id = methodId(method);
+		auto [found, inserted] = methods_.try_emplace(id);
+		auto& entry = found->second;
+		if (inserted) {
+			entry.limits = options_.default_limits;
+			for (const auto& [uri, limits] : options_.methods) {
+				if (methodId(uri) == id) {
+					entry.limits = limits;
+				}
+			}
+		}
+
+		if (entry.running < entry.limits.max_concurrent) {
+			++entry.running;
+			ready_.emplace_back(&entry, std::move(request));
+			lock.unlock();
+			ready_cv_.notify_one();
+			return;
+		}
+
+		auto& queue = entry.queues[band(request.priority)];
+		if (entry.waiting < entry.limits.queue_capacity) {
+			queue.push_back(std::move(request));
+			++entry.waiting;
+		} else {
+			// Make room by shedding the newest of the lowest priority
+			// requests, unless none is below this one.
+			auto lowest = std::find_if(
+			    entry.queues.begin(), entry.queues.end(),
+			    [](const auto& waiting) { return !waiting.empty(); });
+			if (lowest == entry.queues.end() || &*lowest >= &queue) {
+				shed = std::move(request);
+			} else {
+				shed = std::move(lowest->back());
+				lowest->pop_back();
+				queue.push_back(std::move(request));
+			}
+		}
+	}
+
+	if (shed && shed->reject) {
+		shed->reject();
+	}
+}
+
+std::optional<RequestAdmission::Request> RequestAdmission::next(
+    Method& method, std::vector<Request>& expired) {
+	auto now = std::chrono::system_clock::now();
+	for (size_t band = PRIORITY_BANDS; band-- > 0;) {
+		auto& queue = method.queues[band];
+		while (!queue.empty()) {
+			auto request = std::move(queue.front());
+			queue.pop_front();
+			--method.waiting;
+			if (request.deadline && now > *request.deadline) {
+				expired.push_back(std::move(request));
+				continue;
+			}
+			return request;
+		}
+	}
+	return std::nullopt;
+}
+
+void RequestAdmission::runWorker() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true) {
+		ready_cv_.wait(lock, [this]() { return stopping_ || !ready_.empty(); });
+		if (stopping_) {
+			return;
+		}
+		auto [method, request] = std::move(ready_.front());
+		ready_.pop_front();
+
+		lock.unlock();
+		request.handle();
+		request = {};
+		lock.lock();
+
+		// The slot goes straight to the next waiting request, if any.
+		std::vector<Request> expired;
+		if (auto waiting = next(*method, expired)) {
+			ready_.emplace_back(method, std::move(*waiting));
+		} else {
+			--method->running;
+		}
+
+		if (!expired.empty()) {
+			lock.unlock();
+			for (auto& stale : expired) {
+				if (stale.expire) {
+					stale.expire();
+				}
+			}
+			lock.lock();
+		}
+	}
+}
+
+}  // namespace uprotocol::transport
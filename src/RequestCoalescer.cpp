@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/RequestCoalescer.h"
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace uprotocol::transport {
+
+namespace {
+
+constexpr size_t MIN_SWEEP_AT = 64;
+
+void appendInt(std::string& out, uint64_t value, size_t bytes) {
+	for (size_t i = 0; i < bytes; ++i) {
+		out += static_cast<char>((value >> (8 * i)) & 0xFF);
+	}
+}
+
+void appendUri(std::string& out, const v1::UUri& uri) {
+	appendInt(out, uri.authority_name().size(), 4);
+	out += uri.authority_name();
+	appendInt(out, uri.ue_id(), 4);
+	appendInt(out, uri.ue_version_major(), 1);
+	appendInt(out, uri.resource_id(), 2);
+}
+
+}  // namespace
+
+RequestCoalescer::RequestCoalescer(const std::vector<v1::UUri>& methods)
+    : sweep_at_(MIN_SWEEP_AT) {
+	for (const auto& method : methods) {
+		methods_.insert(methodId(method));
+	}
+}
+
+uint64_t RequestCoalescer::methodId(const v1::UUri& method) {
+	return (static_cast<uint64_t>(method.ue_id()) << 24) |
+	       (static_cast<uint64_t>(method.ue_version_major() & 0xFF) << 16) |
+	       (method.resource_id() & 0xFFFF);
+}
+
+std::string RequestCoalescer::flightKey(const v1::UAttributes& request,
+                                        const std::string& payload) {
+	std::string key;
+	key.reserve(64);
+	appendUri(key, request.sink());
+	appendUri(key, request.source());
+	appendInt(key, static_cast<uint64_t>(request.payload_format()), 1);
+	appendInt(key, std::hash<std::string_view>()(payload), sizeof(size_t));
+	return key;
+}
+
+bool RequestCoalescer::join(const v1::UAttributes& request,
+                            const std::string& payload) {
+	// A flight without a TTL would never be swept if its response is lost.
+	if (request.ttl() == 0 || methods_.count(methodId(request.sink())) == 0) {
+		return false;
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	auto key = flightKey(request, payload);
+	auto id = RequestId::of(request.id());
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto [found, inserted] = flights_.try_emplace(std::move(key));
+	auto& flight = found->second;
+	if (!inserted) {
+		if (now < flight.deadline) {
+			if (flight.payload != payload) {
+				// Another payload with the same hash.
+				return false;
+			}
+			flight.followers.push_back(id);
+			return true;
+		}
+		leaders_.erase(flight.leader);
+	}
+
+	flight.leader = id;
+	flight.payload = payload;
+	flight.deadline = now + std::chrono::milliseconds(request.ttl());
+	flight.followers.clear();
+	leaders_.emplace(id, found->first);
+
+	if (flights_.size() >= sweep_at_) {
+		sweep(now);
+	}
+	return false;
+}
+
+void RequestCoalescer::abandon(const v1::UUID& request_id) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	land(request_id);
+}
+
+std::vector<v1::UUID> RequestCoalescer::complete(const v1::UUID& request_id) {
+	std::vector<RequestId> followers;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		followers = land(request_id);
+	}
+
+	std::vector<v1::UUID> ids;
+	ids.reserve(followers.size());
+	for (const auto& follower : followers) {
+		ids.push_back(follower.uuid());
+	}
+	return ids;
+}
+
+std::vector<RequestId> RequestCoalescer::land(const v1::UUID& request_id) {
+	auto leader = leaders_.find(RequestId::of(request_id));
+	if (leader == leaders_.end()) {
+		return {};
+	}
+	auto flight = flights_.find(leader->second);
+	auto followers = std::move(flight->second.followers);
+	flights_.erase(flight);
+	leaders_.erase(leader);
+	return followers;
+}
+
+void RequestCoalescer::sweep(std::chrono::steady_clock::time_point now) {
+	for (auto flight = flights_.begin(); flight != flights_.end();) {
+		if (flight->second.deadline <= now) {
+			leaders_.erase(flight->second.leader);
+			flight = flights_.erase(flight);
+		} else {
+			++flight;
+		}
+	}
+	// Sweeping again only once the flights have doubled keeps the cost
+	// constant per request.
+	sweep_at_ = std::max(MIN_SWEEP_AT, 2 * flights_.size());
+}
+
+}  // namespace uprotocol::transport
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/RpcDeadlineTracker.h"
+
+namespace uprotocol::transport {
+
+RpcDeadlineTracker::RpcDeadlineTracker(RpcDeadlineOptions options)
+    : options_(std::move(options)),
+      wheel_(options_.tick),
+      reporter_([this]() { run(); }) {}
+
+RpcDeadlineTracker::~RpcDeadlineTracker() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	cv_.notify_one();
+	reporter_.join();
+}
+
+void RpcDeadlineTracker::track(const v1::UAttributes& request) {
+	if (request.ttl() == 0) {
+		return;
+	}
+	auto now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> lock(mutex_);
+	bool was_empty = wheel_.empty();
+	if (was_empty) {
+		// Skip the ticks that passed idle, so the reporter does not have to.
+		std::vector<std::pair<RequestId, v1::UUri>> none;
+		wheel_.advance(now, none);
+	}
+	wheel_.insert(RequestId::of(request.id()), request.sink(),
+	              now + std::chrono::milliseconds(request.ttl()));
+	if (was_empty) {
+		cv_.notify_one();
+	}
+}
+
+bool RpcDeadlineTracker::complete(const v1::UUID& request_id) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return wheel_.erase(RequestId::of(request_id)).has_value();
+}
+
+size_t RpcDeadlineTracker::pending() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return wheel_.size();
+}
+
+void RpcDeadlineTracker::run() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	std::vector<std::pair<RequestId, v1::UUri>> expired;
+	while (!stopping_) {
+		if (wheel_.empty()) {
+			cv_.wait(lock);
+			continue;
+		}
+		auto next = wheel_.nextTick();
+		if (std::chrono::steady_clock::now() < next) {
+			cv_.wait_until(lock, next);
+			continue;
+		}
+
+		wheel_.advance(std::chrono::steady_clock::now(), expired);
+		if (expired.empty()) {
+			continue;
+		}
+
+		lock.unlock();
+		std::vector<ExpiredRequest> batch(expired.size());
+		for (size_t i = 0; i < expired.size(); ++i) {
+			batch[i].id = expired[i].first.uuid();
+			batch[i].method = std::move(expired[i].second);
+		}
+		expired.clear();
+		options_.on_expired(std::move(batch));
+		lock.lock();
+	}
+}
+
+}  // namespace uprotocol::transport
@@ -0,0 +1,258 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/ScannedAttributes.h"
+
+namespace uprotocol::transport {
+
+namespace {
+
+enum WireType : uint32_t {
+	VARINT = 0,
+	FIXED64 = 1,
+	LENGTH_DELIMITED = 2,
+	START_GROUP = 3,
+	END_GROUP = 4,
+	FIXED32 = 5,
+};
+
+// UAttributes field numbers.
+constexpr uint32_t FIELD_ID = 1;
+constexpr uint32_t FIELD_TYPE = 2;
+constexpr uint32_t FIELD_PRIORITY = 5;
+constexpr uint32_t FIELD_TTL = 6;
+constexpr uint32_t FIELD_PERMISSION_LEVEL = 7;
+constexpr uint32_t FIELD_COMMSTATUS = 8;
+constexpr uint32_t FIELD_REQID = 9;
+constexpr uint32_t FIELD_PAYLOAD_FORMAT = 12;
+
+// UUID field numbers.
+constexpr uint32_t FIELD_MSB = 1;
+constexpr uint32_t FIELD_LSB = 2;
+
+// Same as protobuf's default recursion limit.
+constexpr int MAX_GROUP_DEPTH = 100;
+
+class WireReader {
+public:
+	explicit WireReader(std::string_view bytes)
+	    : next_(bytes.data()), end_(bytes.data() + bytes.size()) {}
+
+	[[nodiscard]] bool done() const { return next_ == end_; }
+
+	bool varint(uint64_t& value) {
+		value = 0;
+		// Up to ten bytes. Bits beyond 64 are dropped, as protobuf does.
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			if (next_ == end_) {
+				return false;
+			}
+			auto byte = static_cast<uint8_t>(*next_++);
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool fixed64(uint64_t& value) {
+		if (end_ - next_ < 8) {
+			return false;
+		}
+		value = 0;
+		for (unsigned byte = 0; byte < 8; ++byte) {
+			value |= static_cast<uint64_t>(static_cast<uint8_t>(*next_++))
+			         << (8 * byte);
+		}
+		return true;
+	}
+
+	bool lengthDelimited(std::string_view& contents) {
+		uint64_t length = 0;
+		if (!varint(length) ||
+		    length > static_cast<uint64_t>(end_ - next_)) {
+			return false;
+		}
+		contents = std::string_view(next_, static_cast<size_t>(length));
+		next_ += length;
+		return true;
+	}
+
+	bool tag(uint32_t& field, uint32_t& wire_type) {
+		// Up to five bytes, truncated to 32 bits, as protobuf does.
+		uint32_t tag = 0;
+		for (unsigned shift = 0;; shift += 7) {
+			if (shift > 28 || next_ == end_) {
+				return false;
+			}
+			auto byte = static_cast<uint8_t>(*next_++);
+			tag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) {
+				break;
+			}
+		}
+		field = tag >> 3;
+		wire_type = tag & 0x7;
+		return field != 0;
+	}
+
+	// Skips the value of a field whose tag was just read. An end group tag
+	// is only valid while skipping the matching group.
+	bool skip(uint32_t field, uint32_t wire_type, int depth = 0) {
+		switch (wire_type) {
+			case VARINT: {
+				uint64_t ignored = 0;
+				return varint(ignored);
+			}
+			case FIXED64:
+				return advance(8);
+			case LENGTH_DELIMITED: {
+				std::string_view ignored;
+				return lengthDelimited(ignored);
+			}
+			case FIXED32:
+				return advance(4);
+			case START_GROUP: {
+				if (depth >= MAX_GROUP_DEPTH) {
+					return false;
+				}
+				uint32_t inner_field = 0;
+				uint32_t inner_wire_type = 0;
+				while (tag(inner_field, inner_wire_type)) {
+					if (inner_wire_type == END_GROUP) {
+						return inner_field == field;
+					}
+					if (!skip(inner_field, inner_wire_type, depth + 1)) {
+						return false;
+					}
+				}
+				return false;
+			}
+			case END_GROUP:
+			default:
+				return false;
+		}
+	}
+
+private:
+	bool advance(size_t count) {
+		if (static_cast<size_t>(end_ - next_) < count) {
+			return false;
+		}
+		next_ += count;
+		return true;
+	}
+
+	const char* next_;
+	const char* end_;
+};
+
+// Open enums keep any value, truncated to 32 bits.
+template <typename Enum>
+Enum toEnum(uint64_t value) {
+	return static_cast<Enum>(static_cast<int32_t>(value));
+}
+
+// Fields of a UUID merge into the ones read before, as in protobuf.
+bool scanUuid(std::string_view serialized, uint64_t& msb, uint64_t& lsb) {
+	WireReader reader(serialized);
+	uint32_t field = 0;
+	uint32_t wire_type = 0;
+	while (!reader.done()) {
+		if (!reader.tag(field, wire_type)) {
+			return false;
+		}
+		bool read = true;
+		if (field == FIELD_MSB && wire_type == FIXED64) {
+			read = reader.fixed64(msb);
+		} else if (field == FIELD_LSB && wire_type == FIXED64) {
+			read = reader.fixed64(lsb);
+		} else {
+			read = reader.skip(field, wire_type);
+		}
+		if (!read) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}  // namespace
+
+std::optional<ScannedAttributes> ScannedAttributes::scan(
+    std::string_view serialized) {
+	ScannedAttributes attributes;
+	WireReader reader(serialized);
+	uint32_t field = 0;
+	uint32_t wire_type = 0;
+
+	while (!reader.done()) {
+		if (!reader.tag(field, wire_type)) {
+			return std::nullopt;
+		}
+
+		// A known field with an unexpected wire type is an unknown field
+		// to protobuf, and skipped.
+		if (field == FIELD_ID && wire_type == LENGTH_DELIMITED) {
+			std::string_view id;
+			if (!reader.lengthDelimited(id) ||
+			    !scanUuid(id, attributes.id_msb, attributes.id_lsb)) {
+				return std::nullopt;
+			}
+			continue;
+		}
+		if (field == FIELD_REQID && wire_type == LENGTH_DELIMITED) {
+			std::string_view reqid;
+			if (!reader.lengthDelimited(reqid) ||
+			    !scanUuid(reqid, attributes.reqid_msb, attributes.reqid_lsb)) {
+				return std::nullopt;
+			}
+			continue;
+		}
+		if (wire_type != VARINT) {
+			if (!reader.skip(field, wire_type)) {
+				return std::nullopt;
+			}
+			continue;
+		}
+
+		uint64_t value = 0;
+		if (!reader.varint(value)) {
+			return std::nullopt;
+		}
+		switch (field) {
+			case FIELD_TYPE:
+				attributes.type = toEnum<v1::UMessageType>(value);
+				break;
+			case FIELD_PRIORITY:
+				attributes.priority = toEnum<v1::UPriority>(value);
+				break;
+			case FIELD_TTL:
+				attributes.ttl = static_cast<uint32_t>(value);
+				break;
+			case FIELD_PERMISSION_LEVEL:
+				attributes.permission_level = static_cast<uint32_t>(value);
+				break;
+			case FIELD_COMMSTATUS:
+				attributes.commstatus = toEnum<v1::UCode>(value);
+				break;
+			case FIELD_PAYLOAD_FORMAT:
+				attributes.payload_format = toEnum<v1::UPayloadFormat>(value);
+				break;
+			default:
+				break;
+		}
+	}
+	return attributes;
+}
+
+}  // namespace uprotocol::transport
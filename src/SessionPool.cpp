@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/SessionPool.h"
+
+#include <spdlog/spdlog.h>
+
+namespace uprotocol::transport {
+
+std::mutex SessionPool::mutex_;
+std::map<std::string, std::weak_ptr<zenoh::Session>> SessionPool::sessions_;
+
+std::shared_ptr<zenoh::Session> SessionPool::acquire(const std::string& key,
+                                                     const Opener& open) {
+	// Opening under the lock guarantees that concurrent constructors
+	// sharing a configuration end up with one session, not several.
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	auto it = sessions_.find(key);
+	if (it != sessions_.end()) {
+		if (auto session = it->second.lock()) {
+			return session;
+		}
+	}
+
+	spdlog::info("SessionPool: opening shared session for {}", key);
+	auto session = std::make_shared<zenoh::Session>(open());
+	sessions_[key] = session;
+
+	// Drop registry entries whose sessions have been closed.
+	for (auto entry = sessions_.begin(); entry != sessions_.end();) {
+		if (entry->second.expired()) {
+			entry = sessions_.erase(entry);
+		} else {
+			++entry;
+		}
+	}
+	return session;
+}
+
+size_t SessionPool::size() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	size_t live = 0;
+	for (const auto& [key, session] : sessions_) {
+		if (!session.expired()) {
+			++live;
+		}
+	}
+	return live;
+}
+
+}  // namespace uprotocol::transport
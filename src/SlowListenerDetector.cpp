@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/SlowListenerDetector.h"
+
+#include <spdlog/spdlog.h>
+
+namespace uprotocol::transport {
+
+SlowListenerDetector::Monitor::Monitor(SlowListenerDetector& detector,
+                                       std::string zenoh_key)
+    : detector_(detector) {
+	stats_.zenoh_key = std::move(zenoh_key);
+}
+
+void SlowListenerDetector::Monitor::retire() {
+	retired_ = true;
+	std::unique_lock<std::mutex> lock(detector_.executor_mutex_);
+	if (std::this_thread::get_id() == detector_.executor_.get_id()) {
+		return;
+	}
+	detector_.running_done_.wait(
+	    lock, [this]() { return detector_.running_ != this; });
+}
+
+SlowListenerDetector::SlowListenerDetector(SlowListenerOptions options)
+    : options_(std::move(options)) {}
+
+SlowListenerDetector::~SlowListenerDetector() {
+	{
+		std::lock_guard<std::mutex> lock(executor_mutex_);
+		stopping_ = true;
+	}
+	executor_cv_.notify_all();
+	if (executor_.joinable()) {
+		executor_.join();
+	}
+}
+
+std::shared_ptr<SlowListenerDetector::Monitor> SlowListenerDetector::monitor(
+    std::string zenoh_key) {
+	auto monitor = std::make_shared<Monitor>(*this, std::move(zenoh_key));
+	std::lock_guard<std::mutex> lock(monitors_mutex_);
+	for (auto it = monitors_.begin(); it != monitors_.end();) {
+		if (it->expired()) {
+			it = monitors_.erase(it);
+		} else {
+			++it;
+		}
+	}
+	monitors_.push_back(monitor);
+	return monitor;
+}
+
+void SlowListenerDetector::record(Monitor& monitor,
+                                  std::chrono::nanoseconds wall,
+                                  std::chrono::nanoseconds cpu) {
+	using std::chrono::duration_cast;
+	using std::chrono::microseconds;
+
+	auto wall_us = duration_cast<microseconds>(wall);
+	auto cpu_us = duration_cast<microseconds>(cpu);
+	bool over_budget = options_.budget && wall_us > *options_.budget;
+
+	std::optional<SlowListenerEvent> report;
+	bool isolate = false;
+	{
+		std::lock_guard<std::mutex> lock(monitor.mutex_);
+		auto& stats = monitor.stats_;
+		++stats.invocations;
+		stats.wall_time.record(wall_us);
+		stats.cpu_time.record(cpu_us);
+		if (!over_budget) {
+			return;
+		}
+
+		++stats.overruns;
+		++monitor.unreported_overruns_;
+		if (options_.isolate_after > 0 && !stats.isolated &&
+		    stats.overruns >= options_.isolate_after) {
+			stats.isolated = true;
+			isolate = true;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		if (isolate || monitor.last_report_ ==
+		                   std::chrono::steady_clock::time_point() ||
+		    now - monitor.last_report_ >= options_.report_interval) {
+			report = SlowListenerEvent{stats.zenoh_key, wall_us, cpu_us,
+			                           monitor.unreported_overruns_,
+			                           stats.isolated};
+			monitor.unreported_overruns_ = 0;
+			monitor.last_report_ = now;
+		}
+	}
+
+	if (isolate) {
+		// Set outside the lock; the caller's next invocation is posted.
+		monitor.isolated_ = true;
+	}
+	if (report) {
+		if (options_.on_slow_listener) {
+			options_.on_slow_listener(*report);
+		} else {
+			spdlog::warn(
+			    "Listener for {} took {} us ({} us CPU), budget {} us; {} "
+			    "overruns since last report{}",
+			    report->zenoh_key, report->wall_time.count(),
+			    report->cpu_time.count(), options_.budget->count(),
+			    report->overruns,
+			    isolate ? "; moving it to the dedicated executor" : "");
+		}
+	}
+}
+
+void SlowListenerDetector::post(const std::shared_ptr<Monitor>& monitor,
+                                std::function<void()>&& call) {
+	{
+		std::lock_guard<std::mutex> lock(executor_mutex_);
+		if (executor_queue_.size() >= options_.isolated_queue_capacity) {
+			std::lock_guard<std::mutex> stats_lock(monitor->mutex_);
+			++monitor->stats_.dropped;
+			return;
+		}
+		executor_queue_.push_back({monitor, std::move(call)});
+		if (!executor_.joinable()) {
+			executor_ = std::thread([this]() { runExecutor(); });
+		}
+	}
+	executor_cv_.notify_one();
+}
+
+void SlowListenerDetector::runExecutor() {
+	std::unique_lock<std::mutex> lock(executor_mutex_);
+	while (true) {
+		executor_cv_.wait(lock, [this]() {
+			return stopping_ || !executor_queue_.empty();
+		});
+		if (stopping_) {
+			return;
+		}
+		auto task = std::move(executor_queue_.front());
+		executor_queue_.pop_front();
+		running_ = task.monitor.get();
+
+		lock.unlock();
+		if (!task.monitor->retired_) {
+			measure(*task.monitor, task.call);
+		}
+		task = {};
+		lock.lock();
+
+		running_ = nullptr;
+		running_done_.notify_all();
+	}
+}
+
+std::vector<ListenerStats> SlowListenerDetector::stats() const {
+	std::vector<std::shared_ptr<Monitor>> monitors;
+	{
+		std::lock_guard<std::mutex> lock(monitors_mutex_);
+		for (const auto& weak : monitors_) {
+			if (auto monitor = weak.lock()) {
+				monitors.push_back(std::move(monitor));
+			}
+		}
+	}
+
+	std::vector<ListenerStats> stats;
+	stats.reserve(monitors.size());
+	for (const auto& monitor : monitors) {
+		std::lock_guard<std::mutex> lock(monitor->mutex_);
+		stats.push_back(monitor->stats_);
+	}
+	return stats;
+}
+
+}  // namespace uprotocol::transport
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/StageTracer.h"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+namespace uprotocol::transport {
+
+StageTracer::Ring::Ring(size_t capacity)
+    : slots(capacity), tid(static_cast<int64_t>(::syscall(SYS_gettid))) {}
+
+StageTracer::StageTracer(size_t events_per_thread)
+    : events_per_thread_(events_per_thread) {
+	if (events_per_thread_ == 0) {
+		throw std::invalid_argument("StageTracer needs a non-empty buffer");
+	}
+}
+
+void StageTracer::record(const char* category, const char* name,
+                         int64_t start_ns, int64_t end_ns) {
+	auto& ring = rings_.local(events_per_thread_);
+	auto index = ring.recorded.load(std::memory_order_relaxed);
+	auto& slot = ring.slots[index % ring.slots.size()];
+
+	slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.category.store(category, std::memory_order_relaxed);
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.start_ns.store(start_ns, std::memory_order_relaxed);
+	slot.duration_ns.store(end_ns - start_ns, std::memory_order_relaxed);
+	slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+	ring.recorded.store(index + 1, std::memory_order_release);
+}
+
+void StageTracer::dumpChromeTrace(std::ostream& out) const {
+	auto pid = static_cast<int64_t>(::getpid());
+	bool first = true;
+
+	// Timestamps are written in fixed microseconds; the caller's formatting
+	// is restored afterwards.
+	auto flags = out.flags();
+	auto precision = out.precision();
+
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	out << std::fixed << std::setprecision(3);
+	rings_.forEach([&](Ring& ring) {
+		auto recorded = ring.recorded.load(std::memory_order_acquire);
+		auto capacity = static_cast<uint64_t>(ring.slots.size());
+		auto oldest = recorded > capacity ? recorded - capacity : 0;
+
+		for (auto index = oldest; index < recorded; ++index) {
+			const auto& slot = ring.slots[index % capacity];
+			auto before = slot.sequence.load(std::memory_order_acquire);
+			auto category = slot.category.load(std::memory_order_relaxed);
+			auto name = slot.name.load(std::memory_order_relaxed);
+			auto start_ns = slot.start_ns.load(std::memory_order_relaxed);
+			auto duration_ns =
+			    slot.duration_ns.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			auto after = slot.sequence.load(std::memory_order_relaxed);
+
+			// Skip slots the owning thread has overwritten meanwhile.
+			if (before != 2 * index + 2 || after != before) {
+				continue;
+			}
+
+			out << (first ? "" : ",") << "{\"name\":\"" << name
+			    << "\",\"cat\":\"" << category
+			    << "\",\"ph\":\"X\",\"ts\":"
+			    << static_cast<double>(start_ns) / 1000.0
+			    << ",\"dur\":" << static_cast<double>(duration_ns) / 1000.0
+			    << ",\"pid\":" << pid << ",\"tid\":" << ring.tid << "}";
+			first = false;
+		}
+	});
+	out << "]}";
+
+	out.flags(flags);
+	out.precision(precision);
+}
+
+}  // namespace uprotocol::transport
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/TransportMetrics.h"
+
+namespace uprotocol::transport {
+
+TransportMetrics::TransportMetrics(bool track_latency)
+    : track_latency_(track_latency) {}
+
+TransportMetrics::Counters& TransportMetrics::local(
+    const std::string& zenoh_key) {
+	auto& shard = shards_.local();
+
+	// This thread is the only one inserting into its shard, so it can look
+	// up without the lock.
+	auto counters = shard.counters.find(zenoh_key);
+	if (counters != shard.counters.end()) {
+		return counters->second;
+	}
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto& inserted = shard.counters.try_emplace(zenoh_key).first->second;
+	if (track_latency_) {
+		using Buckets =
+		    std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKET_COUNT>;
+		inserted.latency = std::make_unique<Buckets>();
+	}
+	return inserted;
+}
+
+MetricsSnapshot TransportMetrics::snapshot() const {
+	auto read = [](const std::atomic<uint64_t>& counter) {
+		return counter.load(std::memory_order_relaxed);
+	};
+
+	MetricsSnapshot snapshot;
+	shards_.forEach([&snapshot, &read](Shard& shard) {
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		for (const auto& [zenoh_key, counters] : shard.counters) {
+			auto& topic = snapshot[zenoh_key];
+			topic.messages_sent += read(counters.messages_sent);
+			topic.bytes_sent += read(counters.bytes_sent);
+			topic.send_failures += read(counters.send_failures);
+			topic.messages_received += read(counters.messages_received);
+			topic.bytes_received += read(counters.bytes_received);
+			topic.decode_failures += read(counters.decode_failures);
+			topic.messages_filtered += read(counters.messages_filtered);
+			topic.expired_sends += read(counters.expired_sends);
+			topic.expired_receives += read(counters.expired_receives);
+			topic.requests_shed += read(counters.requests_shed);
+			topic.requests_expired += read(counters.requests_expired);
+			topic.requests_coalesced += read(counters.requests_coalesced);
+			topic.listener_invocations += read(counters.listener_invocations);
+			topic.listener_time +=
+			    std::chrono::nanoseconds(read(counters.listener_ns));
+			if (counters.latency) {
+				for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+					if (auto count = read((*counters.latency)[i])) {
+						topic.delivery_latency.add(i, count);
+					}
+				}
+			}
+		}
+	});
+	return snapshot;
+}
+
+}  // namespace uprotocol::transport
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "up-transport-zenoh-cpp/ZenohConfig.h"
+
+#include <sstream>
+#include <system_error>
+
+namespace uprotocol::transport {
+
+namespace {
+
+std::string jsonBool(bool value) { return value ? "true" : "false"; }
+
+std::string jsonString(const std::string& value) {
+	std::string quoted = "\"";
+	for (char c : value) {
+		auto byte = static_cast<unsigned char>(c);
+		if (byte < 0x20) {
+			// Control characters are not allowed unescaped in strings.
+			constexpr char HEX[] = "0123456789abcdef";
+			quoted += "\\u00";
+			quoted += HEX[byte >> 4];
+			quoted += HEX[byte & 0xF];
+			continue;
+		}
+		if (c == '"' || c == '\\') {
+			quoted += '\\';
+		}
+		quoted += c;
+	}
+	quoted += '"';
+	return quoted;
+}
+
+std::string jsonStringArray(const std::vector<std::string>& values) {
+	std::string array = "[";
+	for (size_t i = 0; i < values.size(); ++i) {
+		if (i > 0) {
+			array += ",";
+		}
+		array += jsonString(values[i]);
+	}
+	array += "]";
+	return array;
+}
+
+}  // namespace
+
+ZenohConfig ZenohConfig::fromFile(const std::filesystem::path& path) {
+	ZenohConfig config;
+	config.source_ = Source::File;
+	config.base_ = path.string();
+	return config;
+}
+
+ZenohConfig ZenohConfig::fromJson5(std::string json5) {
+	ZenohConfig config;
+	config.source_ = Source::Json5;
+	config.base_ = std::move(json5);
+	return config;
+}
+
+ZenohConfig& ZenohConfig::mode(Mode mode) {
+	switch (mode) {
+		case Mode::Client:
+			return set("mode", jsonString("client"));
+		case Mode::Router:
+			return set("mode", jsonString("router"));
+		case Mode::Peer:
+		default:
+			return set("mode", jsonString("peer"));
+	}
+}
+
+ZenohConfig& ZenohConfig::connect(const std::vector<std::string>& endpoints) {
+	return set("connect/endpoints", jsonStringArray(endpoints));
+}
+
+ZenohConfig& ZenohConfig::listen(const std::vector<std::string>& endpoints) {
+	return set("listen/endpoints", jsonStringArray(endpoints));
+}
+
+ZenohConfig& ZenohConfig::multicastScouting(bool enabled) {
+	return set("scouting/multicast/enabled", jsonBool(enabled));
+}
+
+ZenohConfig& ZenohConfig::gossipScouting(bool enabled) {
+	return set("scouting/gossip/enabled", jsonBool(enabled));
+}
+
+ZenohConfig& ZenohConfig::batchSize(uint16_t bytes) {
+	return set("transport/link/tx/batch_size", std::to_string(bytes));
+}
+
+ZenohConfig& ZenohConfig::sharedMemory(bool enabled) {
+	return set("transport/shared_memory/enabled", jsonBool(enabled));
+}
+
+ZenohConfig& ZenohConfig::lowLatency(bool enabled) {
+	return set("transport/unicast/lowlatency", jsonBool(enabled));
+}
+
+ZenohConfig& ZenohConfig::qos(bool enabled) {
+	return set("transport/unicast/qos/enabled", jsonBool(enabled));
+}
+
+ZenohConfig& ZenohConfig::compression(bool enabled) {
+	return set("transport/unicast/compression/enabled", jsonBool(enabled));
+}
+
+ZenohConfig& ZenohConfig::set(std::string key, std::string json5_value) {
+	overrides_.emplace_back(std::move(key), std::move(json5_value));
+	return *this;
+}
+
+zenoh::Config ZenohConfig::build() const {
+	auto config = [this]() {
+		switch (source_) {
+			case Source::File:
+				return zenoh::Config::from_file(base_.c_str());
+			case Source::Json5:
+				return zenoh::Config::from_str(base_.c_str());
+			case Source::Default:
+			default:
+				return zenoh::Config::create_default();
+		}
+	}();
+
+	// Later overrides of the same key win, as zenoh applies them in order.
+	for (const auto& [key, value] : overrides_) {
+		config.insert_json5(key, value);
+	}
+	return config;
+}
+
+std::string ZenohConfig::id() const {
+	std::ostringstream id;
+	switch (source_) {
+		case Source::File: {
+			// Falls back to the path as given if it cannot be resolved,
+			// e.g. for lack of permissions.
+			std::error_code error;
+			auto canonical = std::filesystem::weakly_canonical(base_, error);
+			id << "file:" << (error ? base_ : canonical.string());
+			break;
+		}
+		case Source::Json5:
+			id << "json5:" << base_;
+			break;
+		case Source::Default:
+		default:
+			id << "default";
+			break;
+	}
+	for (const auto& [key, value] : overrides_) {
+		id << "|" << key << "=" << value;
+	}
+	return id.str();
+}
+
+}  // namespace uprotocol::transport
@@ -12,14 +12,32 @@
 #include "up-transport-zenoh-cpp/ZenohUTransport.h"
 
 #include <spdlog/spdlog.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+#include <up-cpp/datamodel/builder/Uuid.h>
 #include <up-cpp/datamodel/serializer/UUri.h>
 #include <up-cpp/datamodel/serializer/Uuid.h>
 
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <sstream>
 #include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
 
 namespace uprotocol::transport {
 
 constexpr char UATTRIBUTE_VERSION = 1;
+// Source and sink are left out, and taken from the zenoh key.
+constexpr char UATTRIBUTE_VERSION_COMPACT = 2;
 
 constexpr uint32_t WILDCARD_ENTITY_ID = 0x0000FFFF;
 constexpr uint32_t WILDCARD_ENTITY_VERSION = 0x000000FF;
@@ -32,94 +50,235 @@ v1::UStatus ZenohUTransport::uError(v1::UCode code, std::string_view message) {
 	return status;
 }
 
+namespace {
+
+constexpr uint8_t NOT_HEX = 0xFF;
+
+// Value of every uppercase hex digit by character, NOT_HEX for the others.
+constexpr std::array<uint8_t, 256> HEX_DIGITS = []() {
+	std::array<uint8_t, 256> table{};
+	for (auto& value : table) {
+		value = NOT_HEX;
+	}
+	for (uint8_t digit = 0; digit < 10; ++digit) {
+		table['0' + digit] = digit;
+	}
+	for (uint8_t digit = 0; digit < 6; ++digit) {
+		table['A' + digit] = static_cast<uint8_t>(10 + digit);
+	}
+	return table;
+}();
+
+// An id segment written by appendZenohKey(): hex digits, or "*" for the
+// given wildcard.
+std::optional<uint32_t> parseIdSegment(std::string_view segment,
+                                       uint32_t wildcard) {
+	if (segment == "*") {
+		return wildcard;
+	}
+	if (segment.empty() || segment.size() > 8) {
+		return std::nullopt;
+	}
+	uint32_t value = 0;
+	for (char c : segment) {
+		uint8_t digit = HEX_DIGITS[static_cast<uint8_t>(c)];
+		if (digit == NOT_HEX) {
+			return std::nullopt;
+		}
+		value = (value << 4) | digit;
+	}
+	return value;
+}
+
+}  // namespace
+
 std::string ZenohUTransport::toZenohKeyString(
     const std::string& default_authority_name, const v1::UUri& source,
     const std::optional<v1::UUri>& sink) {
-	std::ostringstream zenoh_key;
+	std::string zenoh_key;
+	appendZenohKey(zenoh_key, default_authority_name, source, sink);
+	return zenoh_key;
+}
 
-	auto writeUUri = [&](const v1::UUri& uuri) {
-		zenoh_key << "/";
+void ZenohUTransport::appendZenohKey(std::string& out,
+                                     const std::string& default_authority_name,
+                                     const v1::UUri& source,
+                                     const std::optional<v1::UUri>& sink) {
+	// Uppercase hex without leading zeros, or "*" for the wildcard.
+	auto writeField = [&out](uint32_t value, uint32_t wildcard) {
+		out += '/';
+		if (value == wildcard) {
+			out += '*';
+			return;
+		}
+		char digits[8];
+		size_t count = 0;
+		do {
+			digits[count++] = "0123456789ABCDEF"[value & 0xF];
+			value >>= 4;
+		} while (value != 0);
+		while (count > 0) {
+			out += digits[--count];
+		}
+	};
 
-		// authority_name
+	auto writeUUri = [&](const v1::UUri& uuri) {
+		out += '/';
 		if (uuri.authority_name().empty()) {
-			zenoh_key << default_authority_name;
+			out += default_authority_name;
 		} else {
-			zenoh_key << uuri.authority_name();
+			out += uuri.authority_name();
 		}
-		zenoh_key << "/";
+		writeField(uuri.ue_id(), WILDCARD_ENTITY_ID);
+		writeField(uuri.ue_version_major(), WILDCARD_ENTITY_VERSION);
+		writeField(uuri.resource_id(), WILDCARD_RESOURCE_ID);
+	};
 
-		// ue_id
-		if (uuri.ue_id() == WILDCARD_ENTITY_ID) {
-			zenoh_key << "*";
-		} else {
-			zenoh_key << std::uppercase << std::hex << uuri.ue_id();
-		}
-		zenoh_key << "/";
+	out += "up";
+	writeUUri(source);
+	if (sink.has_value()) {
+		writeUUri(*sink);
+	} else {
+		out += "/{}/{}/{}/{}";
+	}
+}
 
-		// ue_version_major
-		if (uuri.ue_version_major() == WILDCARD_ENTITY_VERSION) {
-			zenoh_key << "*";
-		} else {
-			zenoh_key << std::uppercase << std::hex << uuri.ue_version_major();
+std::optional<ZenohUTransport::KeyUUris> ZenohUTransport::fromZenohKeyString(
+    std::string_view zenoh_key) {
+	// "up", then authority, ue_id, version and resource_id of the source and
+	// of the sink.
+	constexpr size_t SEGMENTS = 9;
+	std::array<std::string_view, SEGMENTS> segments;
+	size_t count = 0;
+	size_t begin = 0;
+	while (true) {
+		if (count == SEGMENTS) {
+			return std::nullopt;
 		}
-		zenoh_key << "/";
+		size_t end = zenoh_key.find('/', begin);
+		segments[count++] = zenoh_key.substr(begin, end - begin);
+		if (end == std::string_view::npos) {
+			break;
+		}
+		begin = end + 1;
+	}
+	if (count != SEGMENTS || segments[0] != "up") {
+		return std::nullopt;
+	}
 
-		// resource_id
-		if (uuri.resource_id() == WILDCARD_RESOURCE_ID) {
-			zenoh_key << "*";
-		} else {
-			zenoh_key << std::uppercase << std::hex << uuri.resource_id();
+	auto parseUUri = [&segments](size_t first) -> std::optional<v1::UUri> {
+		auto ue_id = parseIdSegment(segments[first + 1], WILDCARD_ENTITY_ID);
+		auto version =
+		    parseIdSegment(segments[first + 2], WILDCARD_ENTITY_VERSION);
+		auto resource_id =
+		    parseIdSegment(segments[first + 3], WILDCARD_RESOURCE_ID);
+		const auto& authority = segments[first];
+		if (authority.empty() || authority == "{}" || !ue_id || !version ||
+		    !resource_id) {
+			return std::nullopt;
 		}
+		v1::UUri uuri;
+		uuri.set_authority_name(std::string(authority));
+		uuri.set_ue_id(*ue_id);
+		uuri.set_ue_version_major(*version);
+		uuri.set_resource_id(*resource_id);
+		return uuri;
 	};
 
-	zenoh_key << "up";
-
-	writeUUri(source);
+	auto source = parseUUri(1);
+	if (!source) {
+		return std::nullopt;
+	}
+	KeyUUris uuris{std::move(*source), std::nullopt};
 
-	if (sink.has_value()) {
-		writeUUri(*sink);
-	} else {
-		zenoh_key << "/{}/{}/{}/{}";
+	bool has_sink = segments[5] != "{}" || segments[6] != "{}" ||
+	                segments[7] != "{}" || segments[8] != "{}";
+	if (has_sink) {
+		uuris.sink = parseUUri(5);
+		if (!uuris.sink) {
+			return std::nullopt;
+		}
 	}
-	return zenoh_key.str();
+	return uuris;
 }
 
 std::vector<std::pair<std::string, std::string>>
-ZenohUTransport::uattributesToAttachment(const v1::UAttributes& attributes) {
+ZenohUTransport::uattributesToAttachment(const v1::UAttributes& attributes,
+                                         bool compact) {
 	std::vector<std::pair<std::string, std::string>> res;
 
-	std::string version(&UATTRIBUTE_VERSION, 1);
+	std::string version(compact ? &UATTRIBUTE_VERSION_COMPACT
+	                            : &UATTRIBUTE_VERSION,
+	                    1);
 
 	std::string data;
-	attributes.SerializeToString(&data);
+	if (compact) {
+		v1::UAttributes stripped = attributes;
+		stripped.clear_source();
+		stripped.clear_sink();
+		stripped.SerializeToString(&data);
+	} else {
+		attributes.SerializeToString(&data);
+	}
 
 	res.emplace_back("", version);
 	res.emplace_back("", data);
 	return res;
 }
 
-v1::UAttributes ZenohUTransport::attachmentToUAttributes(
-    const zenoh::Bytes& attachment) {
+std::optional<ZenohUTransport::AttachmentAttributes>
+ZenohUTransport::splitAttachment(const zenoh::Bytes& attachment) {
 	auto attachment_vec =
 	    attachment
 	        .deserialize<std::vector<std::pair<std::string, std::string>>>();
 
 	if (attachment_vec.size() != 2) {
 		spdlog::error("attachmentToUAttributes: attachment size != 2");
-		// TODO: error report, exception?
+		return std::nullopt;
 	}
 
-	if (attachment_vec[0].second.size() == 1) {
-		if (attachment_vec[0].second[0] != UATTRIBUTE_VERSION) {
-			spdlog::error("attachmentToUAttributes: incorrect version");
-			// TODO: error report, exception?
-		}
-	};
+	const auto& version = attachment_vec[0].second;
+	if (version.size() != 1 || (version[0] != UATTRIBUTE_VERSION &&
+	                            version[0] != UATTRIBUTE_VERSION_COMPACT)) {
+		spdlog::error("attachmentToUAttributes: incorrect version");
+		return std::nullopt;
+	}
+	return AttachmentAttributes{std::move(attachment_vec[1].second),
+	                            version[0] == UATTRIBUTE_VERSION_COMPACT};
+}
+
+std::optional<v1::UAttributes> ZenohUTransport::parseAttachment(
+    const AttachmentAttributes& attachment, std::string_view zenoh_key) {
 	v1::UAttributes res;
-	res.ParseFromString(attachment_vec[1].second);
+	if (!res.ParseFromString(attachment.serialized)) {
+		spdlog::error("attachmentToUAttributes: invalid UAttributes");
+		return std::nullopt;
+	}
+
+	if (attachment.compact) {
+		auto uuris = fromZenohKeyString(zenoh_key);
+		if (!uuris) {
+			spdlog::error("attachmentToUAttributes: invalid key {}",
+			              zenoh_key);
+			return std::nullopt;
+		}
+		*res.mutable_source() = std::move(uuris->source);
+		if (uuris->sink) {
+			*res.mutable_sink() = std::move(*uuris->sink);
+		}
+	}
 	return res;
 }
 
+std::optional<v1::UAttributes> ZenohUTransport::attachmentToUAttributes(
+    const zenoh::Bytes& attachment, std::string_view zenoh_key) {
+	auto split = splitAttachment(attachment);
+	if (!split) {
+		return std::nullopt;
+	}
+	return parseAttachment(*split, zenoh_key);
+}
+
 zenoh::Priority ZenohUTransport::mapZenohPriority(v1::UPriority upriority) {
 	switch (upriority) {
 		case v1::UPriority::UPRIORITY_CS0:
@@ -154,64 +313,1314 @@ zenoh::Priority ZenohUTransport::mapZenohPriority(v1::UPriority upriority) {
 	}
 }
 
-v1::UMessage ZenohUTransport::sampleToUMessage(const zenoh::Sample& sample) {
+std::optional<v1::UMessage> ZenohUTransport::sampleToUMessage(
+    const zenoh::Sample& sample) {
+	auto attachment = splitAttachment(sample.get_attachment());
+	if (!attachment) {
+		return std::nullopt;
+	}
+	return sampleToUMessage(sample, *attachment);
+}
+
+std::optional<v1::UMessage> ZenohUTransport::sampleToUMessage(
+    const zenoh::Sample& sample, const AttachmentAttributes& attachment) {
+	auto attributes =
+	    parseAttachment(attachment, sample.get_keyexpr().as_string_view());
+	if (!attributes) {
+		return std::nullopt;
+	}
 	v1::UMessage message;
-	*message.mutable_attributes() =
-	    attachmentToUAttributes(sample.get_attachment());
+	*message.mutable_attributes() = std::move(*attributes);
 	std::string payload(sample.get_payload().deserialize<std::string>());
 	message.set_payload(payload);
 
 	return message;
 }
 
-v1::UMessage ZenohUTransport::queryToUMessage(const zenoh::Query& query) {
+std::optional<v1::UMessage> ZenohUTransport::queryToUMessage(
+    const zenoh::Query& query) {
+	auto attributes = attachmentToUAttributes(
+	    query.get_attachment(), query.get_keyexpr().as_string_view());
+	if (!attributes) {
+		return std::nullopt;
+	}
 	v1::UMessage message;
-	*message.mutable_attributes() =
-	    attachmentToUAttributes(query.get_attachment());
+	*message.mutable_attributes() = std::move(*attributes);
 	std::string payload(query.get_payload().deserialize<std::string>());
 	message.set_payload(payload);
 
 	return message;
 }
 
+// Lane indexes when ZenohUTransportOptions::priority_lanes is enabled.
+constexpr size_t LANE_STANDARD = 0;
+constexpr size_t LANE_REALTIME = 1;
+constexpr size_t LANE_BULK = 2;
+constexpr size_t LANE_COUNT = 3;
+
+namespace {
+
+// When a received message was published: the zenoh timestamp of the sample
+// if it carries one, otherwise the UUIDv7 timestamp of the message id.
+std::optional<std::chrono::system_clock::time_point> publicationTime(
+    const zenoh::Sample& sample, const v1::UAttributes& attributes) {
+	using std::chrono::system_clock;
+
+	if (auto timestamp = sample.get_timestamp()) {
+		// NTP64 since the UNIX epoch: whole seconds in the upper 32 bits,
+		// fractions of a second in the lower 32.
+		uint64_t ntp64 = timestamp->get_time();
+		uint64_t fraction_ns = ((ntp64 & 0xFFFFFFFFULL) * 1000000000ULL) >> 32;
+		auto since_epoch = std::chrono::seconds(ntp64 >> 32) +
+		                   std::chrono::nanoseconds(fraction_ns);
+		return system_clock::time_point(
+		    std::chrono::duration_cast<system_clock::duration>(since_epoch));
+	}
+
+	// UUIDv7: milliseconds since the UNIX epoch in the upper 48 bits.
+	uint64_t unix_ms = attributes.id().msb() >> 16;
+	if (unix_ms == 0) {
+		return std::nullopt;
+	}
+	return system_clock::time_point(std::chrono::milliseconds(unix_ms));
+}
+
+// When a message with the given UUIDv7 id and TTL expires. Messages without
+// a TTL or a timestamp never do.
+std::optional<std::chrono::system_clock::time_point> expiryTime(
+    uint64_t id_msb, uint32_t ttl_ms) {
+	// UUIDv7: milliseconds since the UNIX epoch in the upper 48 bits.
+	uint64_t unix_ms = id_msb >> 16;
+	if (ttl_ms == 0 || unix_ms == 0) {
+		return std::nullopt;
+	}
+	return std::chrono::system_clock::time_point(
+	    std::chrono::milliseconds(unix_ms + ttl_ms));
+}
+
+// Whether a message has expired, allowing it tolerance more.
+bool isExpired(uint64_t id_msb, uint32_t ttl_ms,
+               std::chrono::milliseconds tolerance) {
+	auto expiry = expiryTime(id_msb, ttl_ms);
+	return expiry && std::chrono::system_clock::now() > *expiry + tolerance;
+}
+
+// Calls work(i) for every i below count, spread over up to one thread per
+// core, the calling thread included.
+template <typename Work>
+void forEachConcurrently(size_t count, Work&& work) {
+	std::atomic<size_t> next{0};
+	auto drain = [&]() {
+		for (size_t i = next++; i < count; i = next++) {
+			work(i);
+		}
+	};
+
+	size_t workers = std::min<size_t>(
+	    count, std::max(1U, std::thread::hardware_concurrency()));
+	std::vector<std::thread> helpers;
+	for (size_t i = 1; i < workers; ++i) {
+		helpers.emplace_back(drain);
+	}
+	drain();
+	for (auto& helper : helpers) {
+		helper.join();
+	}
+}
+
+// Source authority in a key built by toZenohKeyString().
+std::string_view keyAuthority(std::string_view zenoh_key) {
+	// "up/<authority>/..."
+	auto begin = zenoh_key.find('/');
+	if (begin == std::string_view::npos) {
+		return {};
+	}
+	++begin;
+	return zenoh_key.substr(begin, zenoh_key.find('/', begin) - begin);
+}
+
+// Source resource id in a key built by toZenohKeyString(), or nullopt if it
+// is a wildcard or malformed.
+std::optional<uint32_t> parseResourceId(std::string_view zenoh_key) {
+	// "up/<authority>/<ue_id>/<version>/<resource_id>/..."
+	size_t begin = 0;
+	for (int separator = 0; separator < 4; ++separator) {
+		begin = zenoh_key.find('/', begin);
+		if (begin == std::string_view::npos) {
+			return std::nullopt;
+		}
+		++begin;
+	}
+	auto segment = zenoh_key.substr(begin, zenoh_key.find('/', begin) - begin);
+	auto resource_id = parseIdSegment(segment, WILDCARD_RESOURCE_ID);
+	if (resource_id == WILDCARD_RESOURCE_ID) {
+		return std::nullopt;
+	}
+	return resource_id;
+}
+
+// True if the key's sink names a method, rather than any resource or the
+// resource 0 that responses are sent to. The sink resource id is the last
+// segment, "{}" for keys without a sink.
+bool servesMethod(std::string_view zenoh_key) {
+	constexpr uint32_t MAX_METHOD_ID = 0x7FFF;
+	auto resource_id =
+	    parseIdSegment(zenoh_key.substr(zenoh_key.rfind('/') + 1),
+	                   WILDCARD_RESOURCE_ID);
+	return resource_id && *resource_id != 0 && *resource_id <= MAX_METHOD_ID;
+}
+
+// True for the first caller in the process. The zenoh runtime is created
+// while that caller opens its sessions.
+bool claimRuntimeSetup() {
+	static std::atomic<bool> claimed{false};
+	return !claimed.exchange(true);
+}
+
+bool hasRuntimeOptions(const RuntimeOptions& runtime) {
+	return runtime.rx_threads || runtime.tx_threads || runtime.app_threads ||
+	       !runtime.cpu_affinity.empty() || runtime.sched_policy;
+}
+
+// Passes thread counts to the zenoh runtime, which reads ZENOH_RUNTIME when
+// it is created; zenoh has no configuration key for them. The variable is
+// only set while the sessions are opened, so that child processes do not
+// inherit it.
+class ScopedRuntimeThreads {
+public:
+	explicit ScopedRuntimeThreads(const RuntimeOptions& runtime) {
+		std::ostringstream pools;
+		auto addPool = [&pools](const char* name,
+		                        const std::optional<size_t>& threads) {
+			if (threads) {
+				pools << (pools.tellp() > 0 ? ", " : "") << name
+				      << ": (worker_threads: " << *threads << ")";
+			}
+		};
+		addPool("rx", runtime.rx_threads);
+		addPool("tx", runtime.tx_threads);
+		addPool("app", runtime.app_threads);
+		if (pools.tellp() == 0) {
+			return;
+		}
+
+		if (std::getenv("ZENOH_RUNTIME") != nullptr) {
+			spdlog::warn(
+			    "ZENOH_RUNTIME is already set; ignoring runtime thread "
+			    "options");
+			return;
+		}
+		auto value = "(" + pools.str() + ")";
+		spdlog::info("ZenohUTransport: ZENOH_RUNTIME={}", value);
+		set_ = ::setenv("ZENOH_RUNTIME", value.c_str(), 0) == 0;
+	}
+
+	~ScopedRuntimeThreads() {
+		if (set_) {
+			::unsetenv("ZENOH_RUNTIME");
+		}
+	}
+
+	ScopedRuntimeThreads(const ScopedRuntimeThreads&) = delete;
+	ScopedRuntimeThreads& operator=(const ScopedRuntimeThreads&) = delete;
+
+private:
+	bool set_ = false;
+};
+
+// Applies RuntimeOptions affinity and scheduling to the calling thread for
+// the lifetime of the object, so that threads spawned meanwhile inherit
+// them, then restores the previous settings.
+class ScopedThreadPlacement {
+public:
+	explicit ScopedThreadPlacement(const RuntimeOptions& runtime) {
+		pthread_t self = pthread_self();
+
+		if (!runtime.cpu_affinity.empty()) {
+			cpu_set_t wanted;
+			CPU_ZERO(&wanted);
+			for (int cpu : runtime.cpu_affinity) {
+				if (cpu < 0 || cpu >= CPU_SETSIZE) {
+					throw std::invalid_argument("cpu_affinity: invalid CPU " +
+					                            std::to_string(cpu));
+				}
+				CPU_SET(static_cast<size_t>(cpu), &wanted);
+			}
+
+			cpu_set_t saved;
+			check(pthread_getaffinity_np(self, sizeof(saved), &saved),
+			      "pthread_getaffinity_np");
+			check(pthread_setaffinity_np(self, sizeof(wanted), &wanted),
+			      "pthread_setaffinity_np");
+			saved_affinity_ = saved;
+		}
+
+		if (runtime.sched_policy) {
+			int policy = 0;
+			sched_param saved{};
+			check(pthread_getschedparam(self, &policy, &saved),
+			      "pthread_getschedparam");
+
+			sched_param wanted{};
+			wanted.sched_priority = runtime.sched_priority;
+			check(pthread_setschedparam(self, *runtime.sched_policy, &wanted),
+			      "pthread_setschedparam");
+			saved_sched_ = std::make_pair(policy, saved);
+		}
+	}
+
+	~ScopedThreadPlacement() { restore(); }
+
+	ScopedThreadPlacement(const ScopedThreadPlacement&) = delete;
+	ScopedThreadPlacement& operator=(const ScopedThreadPlacement&) = delete;
+
+private:
+	void check(int error, const char* what) {
+		if (error != 0) {
+			restore();
+			throw std::system_error(error, std::generic_category(), what);
+		}
+	}
+
+	void restore() {
+		pthread_t self = pthread_self();
+		if (saved_sched_) {
+			pthread_setschedparam(self, saved_sched_->first,
+			                      &saved_sched_->second);
+			saved_sched_.reset();
+		}
+		if (saved_affinity_) {
+			pthread_setaffinity_np(self, sizeof(*saved_affinity_),
+			                       &*saved_affinity_);
+			saved_affinity_.reset();
+		}
+	}
+
+	std::optional<cpu_set_t> saved_affinity_;
+	std::optional<std::pair<int, sched_param>> saved_sched_;
+};
+
+}  // namespace
+
+std::vector<std::shared_ptr<zenoh::Session>> ZenohUTransport::openSessions(
+    const ZenohConfig& config, const ZenohUTransportOptions& options) {
+	if (options.session_count == 0) {
+		throw std::invalid_argument("session_count must be at least 1");
+	}
+
+	// Both undone once the sessions are open.
+	std::optional<ScopedRuntimeThreads> runtime_threads;
+	std::optional<ScopedThreadPlacement> placement;
+	if (claimRuntimeSetup()) {
+		runtime_threads.emplace(options.runtime);
+		placement.emplace(options.runtime);
+	} else if (hasRuntimeOptions(options.runtime)) {
+		spdlog::warn(
+		    "zenoh runtime already running; ignoring runtime options");
+	}
+
+	std::vector<const PriorityLaneOptions*> lanes{&options.standard_lane};
+	if (options.priority_lanes) {
+		lanes.resize(LANE_COUNT);
+		lanes[LANE_REALTIME] = &options.realtime_lane;
+		lanes[LANE_BULK] = &options.bulk_lane;
+	}
+
+	std::vector<std::shared_ptr<zenoh::Session>> sessions;
+	sessions.reserve(lanes.size() * options.session_count);
+	for (const auto* lane : lanes) {
+		ZenohConfig lane_config = config;
+		if (options.priority_lanes) {
+			if (lane->batch_size) {
+				lane_config.batchSize(*lane->batch_size);
+			}
+			for (const auto& [key, value] : lane->config_overrides) {
+				lane_config.set(key, value);
+			}
+		}
+
+		for (size_t i = 0; i < options.session_count; ++i) {
+			if (options.share_sessions) {
+				// The shard is part of the key so that sharded instances
+				// still get distinct sessions.
+				sessions.push_back(SessionPool::acquire(
+				    lane_config.id() + "|shard=" + std::to_string(i),
+				    [&lane_config]() {
+					    return zenoh::Session::open(lane_config.build());
+				    }));
+			} else {
+				sessions.push_back(std::make_shared<zenoh::Session>(
+				    zenoh::Session::open(lane_config.build())));
+			}
+		}
+	}
+	return sessions;
+}
+
+size_t ZenohUTransport::shardFor(const std::string& zenoh_key) const {
+	if (shard_count_ == 1) {
+		return 0;
+	}
+
+	// FNV-1a: unlike std::hash, stable across builds and processes, so a
+	// topic always maps to the same session and keeps its ordering.
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for (unsigned char c : zenoh_key) {
+		hash = (hash ^ c) * 0x100000001b3ULL;
+	}
+	return hash % shard_count_;
+}
+
+const zenoh::Session& ZenohUTransport::sessionFor(
+    const std::string& zenoh_key, zenoh::Priority priority) const {
+	size_t lane = LANE_STANDARD;
+	if (sessions_.size() > shard_count_) {
+		switch (priority) {
+			case Z_PRIORITY_REAL_TIME:
+			case Z_PRIORITY_INTERACTIVE_HIGH:
+				lane = LANE_REALTIME;
+				break;
+			case Z_PRIORITY_DATA_LOW:
+			case Z_PRIORITY_BACKGROUND:
+				lane = LANE_BULK;
+				break;
+			case Z_PRIORITY_INTERACTIVE_LOW:
+			case Z_PRIORITY_DATA_HIGH:
+			case Z_PRIORITY_DATA:
+			default:
+				break;
+		}
+	}
+
+	return *sessions_[lane * shard_count_ + shardFor(zenoh_key)];
+}
+
+ZenohUTransport::ZenohUTransport(const v1::UUri& defaultUri,
+                                 const std::filesystem::path& configFile,
+                                 const ZenohUTransportOptions& options)
+    : ZenohUTransport(defaultUri, ZenohConfig::fromFile(configFile),
+                      options) {}
+
 ZenohUTransport::ZenohUTransport(const v1::UUri& defaultUri,
-                                 const std::filesystem::path& configFile)
+                                 const ZenohConfig& config,
+                                 const ZenohUTransportOptions& options)
     : UTransport(defaultUri),
-      session_(zenoh::Session::open(
-          std::move(zenoh::Config::from_file(configFile.string().c_str())))) {
+      sessions_(openSessions(config, options)),
+      shard_count_(options.session_count),
+      compact_attachments_(options.compact_attachments),
+      ttl_tolerance_(options.ttl_enforcement.enabled
+                         ? std::make_optional(
+                               options.ttl_enforcement.clock_skew_tolerance)
+                         : std::nullopt),
+      metrics_(options.metrics || options.latency_tracking
+                   ? std::make_unique<TransportMetrics>(
+                         options.latency_tracking)
+                   : nullptr),
+      tracer_(options.trace_events_per_thread > 0
+                  ? std::make_unique<StageTracer>(
+                        options.trace_events_per_thread)
+                  : nullptr),
+      slow_listeners_(options.slow_listeners.budget
+                          ? std::make_unique<SlowListenerDetector>(
+                                options.slow_listeners)
+                          : nullptr),
+      admission_(options.request_admission.worker_threads > 0
+                     ? std::make_unique<RequestAdmission>(
+                           options.request_admission)
+                     : nullptr),
+      rpc_deadlines_(options.rpc_deadlines.on_expired
+                         ? std::make_unique<RpcDeadlineTracker>(
+                               options.rpc_deadlines)
+                         : nullptr),
+      coalescer_(!options.request_coalescing.methods.empty()
+                     ? std::make_unique<RequestCoalescer>(
+                           options.request_coalescing.methods)
+                     : nullptr),
+      retained_subscribers_(
+          options.retention.capacity > 0
+              ? std::make_unique<RetentionPool<SlotSubscriber>>(
+                    options.retention.capacity, options.retention.grace_period)
+              : nullptr),
+      aggregation_threshold_(options.aggregation.threshold) {
 	// TODO: add to setup or remove
 	spdlog::set_level(spdlog::level::debug);
 
 	spdlog::info("ZenohUTransport init");
+
+	if (options.manifest) {
+		warm_up_report_ = declareManifest(*options.manifest);
+	}
+}
+
+ZenohUTransport::~ZenohUTransport() { callback_gate_->close(); }
+
+ZenohUTransport::CallbackGate::Pass::Pass(CallbackGate& gate) : gate_(gate) {
+	// Counted before checking, so that close() either waits for this pass
+	// or is seen by it.
+	++gate_.in_flight;
+	entered_ = !gate_.closed;
+	if (!entered_) {
+		leave();
+	}
+}
+
+ZenohUTransport::CallbackGate::Pass::~Pass() {
+	if (entered_) {
+		leave();
+	}
+}
+
+void ZenohUTransport::CallbackGate::Pass::leave() {
+	if (--gate_.in_flight == 0 && gate_.closed) {
+		std::lock_guard<std::mutex> lock(gate_.mutex);
+		gate_.idle.notify_all();
+	}
+}
+
+void ZenohUTransport::CallbackGate::close() {
+	closed = true;
+	std::unique_lock<std::mutex> lock(mutex);
+	idle.wait(lock, [this]() { return in_flight == 0; });
+}
+
+namespace {
+
+// Slots whose listener is running on this thread, innermost last. zenoh
+// may deliver a sample synchronously from within a listener's own send.
+thread_local std::vector<const void*> delivering_slots;
+
+}  // namespace
+
+void ZenohUTransport::ListenerSlot::attach(Target new_target) {
+	std::lock_guard<std::mutex> lock(mutex);
+	target = std::move(new_target);
+	target->attachment = ++attachments;
+}
+
+void ZenohUTransport::ListenerSlot::detach() {
+	// A listener detaching its own slot cannot wait for itself.
+	auto own = static_cast<size_t>(std::count(
+	    delivering_slots.begin(), delivering_slots.end(), this));
+
+	std::optional<Target> detached;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		detached = std::move(target);
+		target.reset();
+		idle.wait(lock, [this, own]() { return in_flight <= own; });
+	}
+	if (detached && detached->monitor) {
+		detached->monitor->retire();
+	}
+}
+
+template <typename Deliver>
+void ZenohUTransport::ListenerSlot::deliver(
+    Deliver&& deliver, std::optional<uint64_t> attachment) {
+	std::optional<Target> current;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!target || (attachment && target->attachment != *attachment)) {
+			return;
+		}
+		current = target;
+		++in_flight;
+	}
+
+	delivering_slots.push_back(this);
+	std::forward<Deliver>(deliver)(*current);
+	delivering_slots.pop_back();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (--in_flight == 0) {
+		idle.notify_all();
+	}
+}
+
+ZenohUTransport::SlotSubscriber ZenohUTransport::declareSlotSubscriber(
+    const std::string& zenoh_key) {
+	auto slot = std::make_shared<ListenerSlot>();
+	// Samples arriving while no listener is attached are dropped, exactly
+	// as if the subscriber were not declared.
+	auto on_sample = [this, gate = callback_gate_, slot,
+	                  zenoh_key](const zenoh::Sample& sample) {
+		CallbackGate::Pass pass(*gate);
+		if (!pass) {
+			return;
+		}
+		settleResponse(sample);
+		auto route = slot->route.load(std::memory_order_acquire);
+		if (route == ListenerSlot::Route::Aggregate) {
+			return;
+		}
+		if (route == ListenerSlot::Route::Handover) {
+			// Recorded before delivering, so that the group's subscriber
+			// does not deliver the sample again.
+			std::lock_guard<std::mutex> lock(slot->mutex);
+			if (slot->route == ListenerSlot::Route::Aggregate) {
+				return;
+			}
+			if (auto id = messageId(sample)) {
+				slot->handed_over.insert(*id);
+			}
+		}
+		slot->deliver(
+		    [this, &zenoh_key, &slot, &sample](ListenerSlot::Target& target) {
+			    deliverSample(zenoh_key, slot, target, sample);
+		    });
+	};
+	auto on_drop = []() {};
+	return SlotSubscriber{
+	    slot, sessionFor(zenoh_key).declare_subscriber(
+	              zenoh_key, std::move(on_sample), std::move(on_drop))};
+}
+
+std::shared_ptr<SlowListenerDetector::Monitor>
+ZenohUTransport::monitorListener(const std::string& zenoh_key) {
+	return slow_listeners_ ? slow_listeners_->monitor(zenoh_key) : nullptr;
+}
+
+void ZenohUTransport::settleResponse(const zenoh::Sample& sample) {
+	if (!coalescer_ && !rpc_deadlines_) {
+		return;
+	}
+	auto attachment = splitAttachment(sample.get_attachment());
+	if (!attachment) {
+		return;
+	}
+	auto scanned = ScannedAttributes::scan(attachment->serialized);
+	if (!scanned ||
+	    scanned->type != v1::UMessageType::UMESSAGE_TYPE_RESPONSE) {
+		return;
+	}
+
+	auto request_id = RequestId{scanned->reqid_msb, scanned->reqid_lsb}.uuid();
+	std::vector<v1::UUID> followers;
+	if (coalescer_) {
+		followers = coalescer_->complete(request_id);
+	}
+	if (rpc_deadlines_) {
+		rpc_deadlines_->complete(request_id);
+		for (const auto& follower : followers) {
+			rpc_deadlines_->complete(follower);
+		}
+	}
+	if (followers.empty()) {
+		return;
+	}
+
+	// Requests that joined the one answered get a copy of the response.
+	auto message = sampleToUMessage(sample, *attachment);
+	if (!message) {
+		return;
+	}
+	std::vector<v1::UMessage> copies;
+	copies.reserve(followers.size());
+	for (auto& follower : followers) {
+		auto& copy = copies.emplace_back(*message);
+		*copy.mutable_attributes()->mutable_id() =
+		    datamodel::builder::UuidBuilder::getBuilder().build();
+		*copy.mutable_attributes()->mutable_reqid() = std::move(follower);
+	}
+	deliverCopies(sample, *scanned, copies);
+}
+
+void ZenohUTransport::deliverCopies(const zenoh::Sample& sample,
+                                    const ScannedAttributes& scanned,
+                                    const std::vector<v1::UMessage>& copies) {
+	const auto& key = sample.get_keyexpr();
+
+	// Collected first, so that listeners run without the map's lock held.
+	std::vector<std::pair<std::string, std::shared_ptr<ListenerSlot>>> slots;
+	subscriber_map_.for_each(
+	    [&key, &slots](const CallableConn&, RegisteredSubscriber& registered) {
+		    if (zenoh::KeyExpr(registered.zenoh_key).includes(key)) {
+			    slots.emplace_back(registered.zenoh_key, registered.slot);
+		    }
+	    });
+
+	auto authority = keyAuthority(key.as_string_view());
+	for (const auto& [zenoh_key, slot] : slots) {
+		slot->deliver([this, &zenoh_key = zenoh_key, &slot = slot, &sample,
+		               &scanned, &copies,
+		               authority](ListenerSlot::Target& target) {
+			if (target.filter && !target.filter->matches(scanned, authority)) {
+				return;
+			}
+			auto* counters = metrics_ ? &metrics_->local(zenoh_key) : nullptr;
+			for (const auto& copy : copies) {
+				dispatchMessage(zenoh_key, slot, target, sample, counters,
+				                v1::UMessage(copy));
+			}
+		});
+	}
+
+	// Pushed without the lock held, as a full FIFO queue blocks.
+	std::vector<std::shared_ptr<PullReceiver::Queue>> queues;
+	{
+		std::lock_guard<std::mutex> lock(pull_queues_mutex_);
+		for (const auto& [zenoh_key, weak_queue] : pull_queues_) {
+			auto queue = weak_queue.lock();
+			if (queue && zenoh::KeyExpr(zenoh_key).includes(key)) {
+				queues.push_back(std::move(queue));
+			}
+		}
+	}
+	for (const auto& queue : queues) {
+		for (const auto& copy : copies) {
+			queue->push(v1::UMessage(copy));
+		}
+	}
+}
+
+TransportMetrics::Counters* ZenohUTransport::countReceived(
+    const std::string& zenoh_key, const zenoh::Sample& sample) {
+	if (!metrics_) {
+		return nullptr;
+	}
+	auto& counters = metrics_->local(zenoh_key);
+	TransportMetrics::add(counters.messages_received, 1);
+	TransportMetrics::add(counters.bytes_received, sample.get_payload().size());
+	return &counters;
+}
+
+void ZenohUTransport::deliverSample(const std::string& zenoh_key,
+                                    const std::shared_ptr<ListenerSlot>& slot,
+                                    ListenerSlot::Target& target,
+                                    const zenoh::Sample& sample) {
+	StageTracer::Span span(tracer_.get(), "receive", "on_sample");
+
+	auto* counters = countReceived(zenoh_key, sample);
+
+	std::optional<v1::UMessage> message;
+	{
+		StageTracer::Span decode_span(tracer_.get(), "receive",
+		                              "sampleToUMessage");
+		if (!target.filter && !ttl_tolerance_) {
+			message = sampleToUMessage(sample);
+		} else if (auto attachment = splitAttachment(sample.get_attachment())) {
+			// Attributes that do not scan do not parse either.
+			auto scanned = ScannedAttributes::scan(attachment->serialized);
+			if (scanned && target.filter &&
+			    !target.filter->matches(
+			        *scanned,
+			        keyAuthority(sample.get_keyexpr().as_string_view()))) {
+				if (counters) {
+					TransportMetrics::add(counters->messages_filtered, 1);
+				}
+				return;
+			}
+			if (scanned && ttl_tolerance_ &&
+			    isExpired(scanned->id_msb, scanned->ttl, *ttl_tolerance_)) {
+				if (counters) {
+					TransportMetrics::add(counters->expired_receives, 1);
+				}
+				return;
+			}
+			if (scanned) {
+				message = sampleToUMessage(sample, *attachment);
+			}
+		}
+	}
+	if (!message) {
+		if (counters) {
+			TransportMetrics::add(counters->decode_failures, 1);
+		}
+		return;
+	}
+
+	dispatchMessage(zenoh_key, slot, target, sample, counters,
+	                std::move(*message));
+}
+
+void ZenohUTransport::dispatchMessage(const std::string& zenoh_key,
+                                      const std::shared_ptr<ListenerSlot>& slot,
+                                      ListenerSlot::Target& target,
+                                      const zenoh::Sample& sample,
+                                      TransportMetrics::Counters* counters,
+                                      v1::UMessage&& message) {
+	if (counters && metrics_->tracksLatency()) {
+		if (auto published = publicationTime(sample, message.attributes())) {
+			TransportMetrics::recordLatency(
+			    *counters,
+			    std::chrono::duration_cast<std::chrono::microseconds>(
+			        std::chrono::system_clock::now() - *published));
+		}
+	}
+
+	// Only method servers are admitted, so that a request also reaching
+	// wildcard or monitoring listeners is counted against its method once.
+	if (admission_ && target.method_server &&
+	    message.attributes().type() ==
+	        v1::UMessageType::UMESSAGE_TYPE_REQUEST) {
+		admitRequest(zenoh_key, slot, target, std::move(message));
+		return;
+	}
+
+	invokeListener(target, counters, std::move(message));
+}
+
+void ZenohUTransport::invokeListener(ListenerSlot::Target& target,
+                                     TransportMetrics::Counters* counters,
+                                     v1::UMessage&& message) {
+	auto& listener = target.listener;
+	const auto& monitor = target.monitor;
+
+	if (monitor && monitor->isolated()) {
+		slow_listeners_->post(
+		    monitor, [listener, message = std::move(message)]() mutable {
+			    listener(message);
+		    });
+		return;
+	}
+
+	auto invoke = [this, &listener, &monitor, &message]() {
+		StageTracer::Span listener_span(tracer_.get(), "receive", "listener");
+		if (monitor) {
+			slow_listeners_->measure(*monitor,
+			                         [&listener, &message]() {
+				                         listener(message);
+			                         });
+		} else {
+			listener(message);
+		}
+	};
+
+	if (!counters) {
+		invoke();
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	invoke();
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	TransportMetrics::add(counters->listener_invocations, 1);
+	TransportMetrics::add(
+	    counters->listener_ns,
+	    static_cast<uint64_t>(
+	        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+	            .count()));
+}
+
+void ZenohUTransport::admitRequest(const std::string& zenoh_key,
+                                   const std::shared_ptr<ListenerSlot>& slot,
+                                   const ListenerSlot::Target& target,
+                                   v1::UMessage&& message) {
+	// Shared by the handler and the rejection, only one of which runs.
+	auto request = std::make_shared<v1::UMessage>(std::move(message));
+	const auto& attributes = request->attributes();
+
+	RequestAdmission::Request admitted;
+	admitted.priority = attributes.priority();
+	if (auto expiry = expiryTime(attributes.id().msb(), attributes.ttl())) {
+		admitted.deadline =
+		    *expiry + ttl_tolerance_.value_or(std::chrono::milliseconds(0));
+	}
+
+	// Runs through the slot, so that removing the listener waits for a
+	// call in progress, and requests still queued are dropped once it is
+	// removed or replaced.
+	admitted.handle = [this, zenoh_key,
+	                   weak_slot = std::weak_ptr<ListenerSlot>(slot),
+	                   attachment = target.attachment, request]() {
+		auto slot = weak_slot.lock();
+		if (!slot) {
+			return;
+		}
+		slot->deliver(
+		    [this, &zenoh_key, &request](ListenerSlot::Target& target) {
+			    invokeListener(
+			        target, metrics_ ? &metrics_->local(zenoh_key) : nullptr,
+			        std::move(*request));
+		    },
+		    attachment);
+	};
+
+	admitted.reject = [this, zenoh_key, request]() {
+		if (metrics_) {
+			TransportMetrics::add(metrics_->local(zenoh_key).requests_shed, 1);
+		}
+		auto response =
+		    datamodel::builder::UMessageBuilder::response(*request)
+		        .withCommStatus(v1::UCode::RESOURCE_EXHAUSTED)
+		        .build();
+		auto status = send(response);
+		if (status.code() != v1::UCode::OK) {
+			spdlog::warn("admitRequest: rejection not sent: {}",
+			             status.message());
+		}
+	};
+
+	admitted.expire = [this, zenoh_key]() {
+		if (metrics_) {
+			TransportMetrics::add(metrics_->local(zenoh_key).requests_expired,
+			                      1);
+		}
+	};
+
+	admission_->submit(attributes.sink(), std::move(admitted));
+}
+
+MetricsSnapshot ZenohUTransport::metricsSnapshot() const {
+	return metrics_ ? metrics_->snapshot() : MetricsSnapshot{};
+}
+
+size_t ZenohUTransport::pendingRequests() const {
+	return rpc_deadlines_ ? rpc_deadlines_->pending() : 0;
+}
+
+std::vector<ListenerStats> ZenohUTransport::listenerStats() const {
+	return slow_listeners_ ? slow_listeners_->stats()
+	                       : std::vector<ListenerStats>{};
+}
+
+RetentionStats ZenohUTransport::retentionStats() const {
+	return retained_subscribers_ ? retained_subscribers_->stats()
+	                             : RetentionStats{};
+}
+
+void ZenohUTransport::dumpTrace(std::ostream& out) const {
+	if (tracer_) {
+		tracer_->dumpChromeTrace(out);
+	} else {
+		out << "{\"traceEvents\":[]}";
+	}
+}
+
+WarmUpReport ZenohUTransport::declareManifest(
+    const DeclarationManifest& manifest) {
+	auto start = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> manifest_lock(manifest_mutex_);
+
+	struct Declaration {
+		std::string zenoh_key;
+		/// Set for publishers, empty for subscribers.
+		std::optional<zenoh::Priority> priority;
+	};
+	std::vector<Declaration> declarations;
+	declarations.reserve(manifest.publications.size() +
+	                     manifest.subscriptions.size());
+
+	// Keys listed twice, or already declared, are skipped. Listeners may
+	// take pre-declared subscribers meanwhile, but nothing else adds any.
+	std::unordered_set<std::string> publication_keys;
+	{
+		std::shared_lock<std::shared_mutex> lock(publishers_mutex_);
+		for (const auto& publication : manifest.publications) {
+			auto zenoh_key =
+			    toZenohKeyString(getEntityUri().authority_name(),
+			                     publication.source, publication.sink);
+			if (publishers_.count(zenoh_key) == 0 &&
+			    publication_keys.insert(zenoh_key).second) {
+				declarations.push_back(
+				    {std::move(zenoh_key),
+				     mapZenohPriority(publication.priority)});
+			}
+		}
+	}
+	std::unordered_set<std::string> subscription_keys;
+	for (const auto& subscription : manifest.subscriptions) {
+		auto zenoh_key = toZenohKeyString(getEntityUri().authority_name(),
+		                                  subscription.source_filter,
+		                                  subscription.sink_filter);
+		if (!predeclared_map_.find(zenoh_key) &&
+		    subscription_keys.insert(zenoh_key).second) {
+			declarations.push_back({std::move(zenoh_key), std::nullopt});
+		}
+	}
+
+	WarmUpReport report;
+	std::mutex report_mutex;
+
+	forEachConcurrently(declarations.size(), [&](size_t i) {
+		const auto& declaration = declarations[i];
+		try {
+			if (declaration.priority) {
+				zenoh::Session::PublisherOptions options;
+				options.priority = *declaration.priority;
+				DeclaredPublisher publisher{
+				    *declaration.priority,
+				    sessionFor(declaration.zenoh_key, *declaration.priority)
+				        .declare_publisher(
+				            zenoh::KeyExpr(declaration.zenoh_key),
+				            std::move(options))};
+				{
+					std::unique_lock<std::shared_mutex> lock(
+					    publishers_mutex_);
+					if (!publishers_
+					         .try_emplace(declaration.zenoh_key,
+					                      std::move(publisher))
+					         .second) {
+						return;
+					}
+				}
+				has_publishers_ = true;
+
+				std::lock_guard<std::mutex> lock(report_mutex);
+				++report.publishers;
+			} else {
+				auto predeclared = std::make_shared<SlotSubscriber>(
+				    declareSlotSubscriber(declaration.zenoh_key));
+				if (!predeclared_map_
+				         .emplace(declaration.zenoh_key, predeclared)
+				         .second) {
+					reaper_.dispose(std::move(predeclared->subscriber));
+					return;
+				}
+
+				std::lock_guard<std::mutex> lock(report_mutex);
+				++report.subscribers;
+			}
+		} catch (const zenoh::ZException& e) {
+			spdlog::error("declareManifest: {}: {}", declaration.zenoh_key,
+			              e.what());
+			std::lock_guard<std::mutex> lock(report_mutex);
+			report.failed_keys.push_back(declaration.zenoh_key);
+		}
+	});
+
+	report.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+	    std::chrono::steady_clock::now() - start);
+	spdlog::info(
+	    "declareManifest: {} publishers, {} subscribers, {} failed in {} us",
+	    report.publishers, report.subscribers, report.failed_keys.size(),
+	    report.duration.count());
+	return report;
 }
 
 v1::UStatus ZenohUTransport::registerPublishNotificationListener_(
-    const std::string& zenoh_key, CallableConn listener) {
+    const std::string& zenoh_key, CallableConn listener,
+    std::shared_ptr<const CompiledAttributeFilter> filter) {
 	spdlog::info("registerPublishNotificationListener_: {}", zenoh_key);
 
-	// NOTE: listener is captured by copy here so that it does not go out
-	// of scope when this function returns.
-	auto on_sample = [this, listener](const zenoh::Sample& sample) mutable {
-		listener(sampleToUMessage(sample));
-	};
+	auto idle = takeIdleSubscriber(zenoh_key);
+	if (!idle) {
+		// Subscribers always deliver through a slot, so that
+		// cleanupListener() can stop deliveries without waiting for the
+		// undeclaration.
+		idle = declareSlotSubscriber(zenoh_key);
+	}
+	subscriber_map_.emplace(
+	    listener, attachListener(zenoh_key, listener, std::move(*idle),
+	                             std::move(filter)));
+	return v1::UStatus();
+}
 
-	auto on_drop = []() {};
+std::pair<ZenohUTransport::ListenHandle, ZenohUTransport::CallableConn>
+ZenohUTransport::connectListener(ListenCallback&& listener) {
+	using Connection = utils::callbacks::Connection<void, const v1::UMessage&>;
+
+	auto [handle, callable] = Connection::establish(
+	    std::move(listener), [this](auto conn) { cleanupListener(conn); });
+	return {std::move(handle), std::move(callable)};
+}
+
+bool ZenohUTransport::isAggregatable(const v1::UUri& source_filter) const {
+	return aggregation_threshold_ > 0 &&
+	       source_filter.resource_id() != WILDCARD_RESOURCE_ID;
+}
+
+std::optional<ZenohUTransport::SlotSubscriber>
+ZenohUTransport::takeIdleSubscriber(const std::string& zenoh_key) {
+	if (auto predeclared = predeclared_map_.extract(zenoh_key)) {
+		return std::move(**predeclared);
+	}
+	if (retained_subscribers_) {
+		return retained_subscribers_->take(zenoh_key);
+	}
+	return std::nullopt;
+}
+
+ZenohUTransport::RegisteredSubscriber ZenohUTransport::attachListener(
+    const std::string& zenoh_key, const CallableConn& listener,
+    SlotSubscriber&& idle,
+    std::shared_ptr<const CompiledAttributeFilter> filter) {
+	idle.slot->attach({listener, monitorListener(zenoh_key), std::move(filter),
+	                   servesMethod(zenoh_key)});
+	return RegisteredSubscriber{zenoh_key, std::move(idle.slot),
+	                            std::move(idle.subscriber)};
+}
+
+v1::UStatus ZenohUTransport::registerAggregatableListener_(
+    const std::string& zenoh_key, const v1::UUri& source_filter,
+    const std::optional<v1::UUri>& sink_filter, CallableConn listener,
+    std::shared_ptr<const CompiledAttributeFilter> filter) {
+	v1::UUri any_resource = source_filter;
+	any_resource.set_resource_id(WILDCARD_RESOURCE_ID);
+	auto aggregate_key = toZenohKeyString(getEntityUri().authority_name(),
+	                                      any_resource, sink_filter);
+	// Listeners are grouped by the session their own subscribers are on,
+	// and the group's subscriber is declared on it too. That session then
+	// hands each sample to both subscribers in turn during the handover.
+	auto shard = shardFor(zenoh_key);
+
+	auto member = std::make_shared<AggregateGroup::Member>(
+	    AggregateGroup::Member{listener, source_filter.resource_id(),
+	                           zenoh_key, nullptr});
+
+	{
+		std::lock_guard<std::mutex> lock(aggregation_mutex_);
+		auto found = aggregates_.find({aggregate_key, shard});
+		if (found != aggregates_.end()) {
+			auto group = found->second;
+			std::lock_guard<std::mutex> group_lock(group->mutex);
+			if (group->subscriber) {
+				// Served by the group from the start.
+				member->slot = std::make_shared<ListenerSlot>();
+				member->slot->route = ListenerSlot::Route::Aggregate;
+				member->slot->attach({listener, monitorListener(zenoh_key),
+				                      std::move(filter),
+				                      servesMethod(zenoh_key)});
+				subscriber_map_.emplace(
+				    listener, RegisteredSubscriber{zenoh_key, member->slot,
+				                                   std::nullopt, group});
+				group->by_resource.emplace(member->resource_id, member);
+				group->members.emplace(listener, std::move(member));
+				return v1::UStatus();
+			}
+		}
+	}
+
+	// Below the threshold, the listener gets a subscriber of its own. It is
+	// declared without any lock held, as that may wait on the network.
+	v1::UStatus status;
+	try {
+		status = registerPublishNotificationListener_(zenoh_key, listener,
+		                                              std::move(filter));
+	} catch (const zenoh::ZException& e) {
+		status = uError(v1::UCode::INTERNAL, e.what());
+	}
+	if (status.code() != v1::UCode::OK) {
+		return status;
+	}
 
-	auto subscriber = session_.declare_subscriber(
-	    zenoh_key, std::move(on_sample), std::move(on_drop));
-	subscriber_map_.emplace(listener, std::move(subscriber));
+	std::shared_ptr<AggregateGroup> group;
+	{
+		std::lock_guard<std::mutex> lock(aggregation_mutex_);
+		auto& entry = aggregates_[{aggregate_key, shard}];
+		if (!entry) {
+			entry = std::make_shared<AggregateGroup>(aggregate_key, shard);
+		}
+		group = entry;
+		std::lock_guard<std::mutex> group_lock(group->mutex);
+
+		subscriber_map_.update(listener, [&group, &member](auto& registered) {
+			registered.aggregate = group;
+			member->slot = registered.slot;
+		});
+		group->members.emplace(listener, member);
+		if (group->subscriber) {
+			// The group went live while the subscriber was declared.
+			handOver(*group, member);
+			return v1::UStatus();
+		}
+		if (group->declaring ||
+		    group->members.size() < aggregation_threshold_) {
+			return v1::UStatus();
+		}
+		group->declaring = true;
+	}
+	aggregate(group);
 	return v1::UStatus();
 }
 
+void ZenohUTransport::aggregate(const std::shared_ptr<AggregateGroup>& group) {
+	std::weak_ptr<AggregateGroup> weak_group = group;
+	auto on_sample = [this, gate = callback_gate_,
+	                  weak_group](const zenoh::Sample& sample) {
+		CallbackGate::Pass pass(*gate);
+		if (!pass) {
+			return;
+		}
+		settleResponse(sample);
+		auto group = weak_group.lock();
+		if (!group) {
+			return;
+		}
+		auto resource_id =
+		    parseResourceId(sample.get_keyexpr().as_string_view());
+		if (!resource_id) {
+			return;
+		}
+
+		// Copied, so that listeners run without the group's lock held.
+		std::vector<std::shared_ptr<AggregateGroup::Member>> matches;
+		{
+			std::lock_guard<std::mutex> lock(group->mutex);
+			auto [begin, end] = group->by_resource.equal_range(*resource_id);
+			for (auto it = begin; it != end; ++it) {
+				matches.push_back(it->second);
+			}
+		}
+		for (const auto& member : matches) {
+			if (member->slot->route.load(std::memory_order_acquire) ==
+			        ListenerSlot::Route::Handover &&
+			    !completeHandover(*member, sample)) {
+				continue;
+			}
+			member->slot->deliver(
+			    [this, &member, &sample](ListenerSlot::Target& target) {
+				    deliverSample(member->zenoh_key, member->slot, target,
+				                  sample);
+			    });
+		}
+	};
+	auto on_drop = []() {};
+
+	std::optional<zenoh::Subscriber<void>> subscriber;
+	try {
+		// On the standard lane, like every subscriber.
+		const auto& session =
+		    *sessions_[LANE_STANDARD * shard_count_ + group->shard];
+		subscriber.emplace(session.declare_subscriber(
+		    group->zenoh_key, std::move(on_sample), std::move(on_drop)));
+	} catch (const zenoh::ZException& e) {
+		// The members keep their own subscribers, and the next one to join
+		// tries again.
+		spdlog::error("aggregate: {}: {}", group->zenoh_key, e.what());
+	}
+
+	std::lock_guard<std::mutex> lock(group->mutex);
+	group->declaring = false;
+	if (!subscriber) {
+		return;
+	}
+	if (group->members.empty()) {
+		// The last member left meanwhile, taking the group with it.
+		reaper_.dispose(std::move(*subscriber));
+		return;
+	}
+	group->subscriber = std::move(subscriber);
+	for (const auto& [listener, member] : group->members) {
+		handOver(*group, member);
+	}
+	spdlog::info("aggregate: {} listeners on {}", group->members.size(),
+	             group->zenoh_key);
+}
+
+void ZenohUTransport::handOver(
+    AggregateGroup& group,
+    const std::shared_ptr<AggregateGroup::Member>& member) {
+	// Both subscribers deliver until the group's first sample for the
+	// member, which completeHandover() checks against the samples the own
+	// subscriber delivered meanwhile.
+	{
+		std::lock_guard<std::mutex> lock(member->slot->mutex);
+		member->slot->route = ListenerSlot::Route::Handover;
+	}
+	group.by_resource.emplace(member->resource_id, member);
+}
+
+bool ZenohUTransport::completeHandover(const AggregateGroup::Member& member,
+                                       const zenoh::Sample& sample) {
+	auto id = messageId(sample);
+	bool delivered = false;
+	{
+		std::lock_guard<std::mutex> lock(member.slot->mutex);
+		if (member.slot->route != ListenerSlot::Route::Handover) {
+			return true;
+		}
+		delivered = id && member.slot->handed_over.count(*id) > 0;
+		member.slot->handed_over.clear();
+		member.slot->route = ListenerSlot::Route::Aggregate;
+	}
+
+	subscriber_map_.update(member.listener, [this](auto& registered) {
+		if (registered.subscriber) {
+			reaper_.dispose(std::move(*registered.subscriber));
+			registered.subscriber.reset();
+		}
+	});
+	return !delivered;
+}
+
+void ZenohUTransport::leaveAggregate(
+    const std::shared_ptr<AggregateGroup>& group,
+    const CallableConn& listener) {
+	std::lock_guard<std::mutex> lock(aggregation_mutex_);
+	std::lock_guard<std::mutex> group_lock(group->mutex);
+
+	auto member = group->members.find(listener);
+	if (member != group->members.end()) {
+		auto [begin, end] =
+		    group->by_resource.equal_range(member->second->resource_id);
+		for (auto it = begin; it != end; ++it) {
+			if (it->second == member->second) {
+				group->by_resource.erase(it);
+				break;
+			}
+		}
+		group->members.erase(member);
+	}
+
+	if (group->members.empty()) {
+		if (group->subscriber) {
+			reaper_.dispose(std::move(*group->subscriber));
+			group->subscriber.reset();
+		}
+		auto found = aggregates_.find({group->zenoh_key, group->shard});
+		if (found != aggregates_.end() && found->second == group) {
+			aggregates_.erase(found);
+		}
+	}
+}
+
+std::optional<RequestId> ZenohUTransport::messageId(
+    const zenoh::Sample& sample) {
+	auto attachment = splitAttachment(sample.get_attachment());
+	if (!attachment) {
+		return std::nullopt;
+	}
+	auto scanned = ScannedAttributes::scan(attachment->serialized);
+	if (!scanned) {
+		return std::nullopt;
+	}
+	return RequestId{scanned->id_msb, scanned->id_lsb};
+}
+
 v1::UStatus ZenohUTransport::sendPublishNotification_(
     const std::string& zenoh_key, const std::string& payload,
     const v1::UAttributes& attributes) {
+	StageTracer::Span span(tracer_.get(), "send", "sendPublishNotification_");
 	spdlog::debug("sendPublishNotification_: {}: {}", zenoh_key, payload);
-	auto attachment = uattributesToAttachment(attributes);
+	auto attachment = [this, &attributes]() {
+		StageTracer::Span attachment_span(tracer_.get(), "send",
+		                                  "uattributesToAttachment");
+		return uattributesToAttachment(attributes, compact_attachments_);
+	}();
 
 	auto priority = mapZenohPriority(attributes.priority());
 
+	TransportMetrics::Counters* counters =
+	    metrics_ ? &metrics_->local(zenoh_key) : nullptr;
+	auto sent = [counters, &payload]() {
+		if (counters) {
+			TransportMetrics::add(counters->messages_sent, 1);
+			TransportMetrics::add(counters->bytes_sent, payload.size());
+		}
+		return v1::UStatus();
+	};
+
 	try {
+		StageTracer::Span put_span(tracer_.get(), "send", "put");
+		DeclaredPublisher* declared = nullptr;
+		if (has_publishers_) {
+			std::shared_lock<std::shared_mutex> lock(publishers_mutex_);
+			auto found = publishers_.find(zenoh_key);
+			if (found != publishers_.end() &&
+			    found->second.priority == priority) {
+				declared = &found->second;
+			}
+		}
+		if (declared) {
+			zenoh::Publisher::PutOptions options;
+			options.encoding = zenoh::Encoding("app/custom");
+			options.attachment = attachment;
+			declared->publisher.put(zenoh::Bytes::serialize(payload),
+			                        std::move(options));
+			return sent();
+		}
+
 		// -Wpedantic disallows named member initialization until C++20,
 		// so PutOptions needs to be explicitly created and passed with
 		// std::move()
@@ -219,45 +1628,322 @@ v1::UStatus ZenohUTransport::sendPublishNotification_(
 		options.priority = priority;
 		options.encoding = zenoh::Encoding("app/custom");
 		options.attachment = attachment;
-		session_.put(zenoh::KeyExpr(zenoh_key),
-		             zenoh::Bytes::serialize(payload), std::move(options));
+		sessionFor(zenoh_key, priority)
+		    .put(zenoh::KeyExpr(zenoh_key), zenoh::Bytes::serialize(payload),
+		         std::move(options));
 	} catch (const zenoh::ZException& e) {
+		if (counters) {
+			TransportMetrics::add(counters->send_failures, 1);
+		}
 		return uError(v1::UCode::INTERNAL, e.what());
 	}
 
-	return v1::UStatus();
+	return sent();
 }
 
 // NOTE: Messages have already been validated by the base class. It does not
 // need to be re-checked here.
 v1::UStatus ZenohUTransport::sendImpl(const v1::UMessage& message) {
+	StageTracer::Span span(tracer_.get(), "send", "sendImpl");
 	const auto& payload = message.payload();
 
 	const auto& attributes = message.attributes();
 
 	std::string zenoh_key;
-	if (attributes.type() == v1::UMessageType::UMESSAGE_TYPE_PUBLISH) {
-		zenoh_key = toZenohKeyString(getEntityUri().authority_name(),
-		                             attributes.source(), {});
-	} else {
-		zenoh_key = toZenohKeyString(getEntityUri().authority_name(),
-		                             attributes.source(), attributes.sink());
+	{
+		StageTracer::Span key_span(tracer_.get(), "send", "toZenohKeyString");
+		if (attributes.type() == v1::UMessageType::UMESSAGE_TYPE_PUBLISH) {
+			zenoh_key = toZenohKeyString(getEntityUri().authority_name(),
+			                             attributes.source(), {});
+		} else {
+			zenoh_key =
+			    toZenohKeyString(getEntityUri().authority_name(),
+			                     attributes.source(), attributes.sink());
+		}
+	}
+
+	if (ttl_tolerance_ &&
+	    isExpired(attributes.id().msb(), attributes.ttl(), *ttl_tolerance_)) {
+		if (metrics_) {
+			TransportMetrics::add(metrics_->local(zenoh_key).expired_sends, 1);
+		}
+		return uError(v1::UCode::DEADLINE_EXCEEDED, "Message expired");
+	}
+
+	if (attributes.type() != v1::UMessageType::UMESSAGE_TYPE_REQUEST) {
+		return sendPublishNotification_(zenoh_key, payload, attributes);
 	}
 
-	return sendPublishNotification_(zenoh_key, payload, attributes);
+	// Tracked before sending, as the response may arrive before put()
+	// returns.
+	if (rpc_deadlines_) {
+		rpc_deadlines_->track(attributes);
+	}
+	if (coalescer_ && coalescer_->join(attributes, payload)) {
+		// Answered along with the identical request in flight.
+		if (metrics_) {
+			TransportMetrics::add(
+			    metrics_->local(zenoh_key).requests_coalesced, 1);
+		}
+		return {};
+	}
+
+	auto status = sendPublishNotification_(zenoh_key, payload, attributes);
+	if (status.code() != v1::UCode::OK) {
+		if (rpc_deadlines_) {
+			rpc_deadlines_->complete(attributes.id());
+		}
+		if (coalescer_) {
+			coalescer_->abandon(attributes.id());
+		}
+	}
+	return status;
 }
 
 v1::UStatus ZenohUTransport::registerListenerImpl(
     CallableConn&& listener, const v1::UUri& source_filter,
     std::optional<v1::UUri>&& sink_filter) {
+	return registerListener_(std::move(listener), source_filter, sink_filter,
+	                         nullptr);
+}
+
+v1::UStatus ZenohUTransport::registerListener_(
+    CallableConn listener, const v1::UUri& source_filter,
+    const std::optional<v1::UUri>& sink_filter,
+    std::shared_ptr<const CompiledAttributeFilter> filter) {
 	std::string zenoh_key = toZenohKeyString(getEntityUri().authority_name(),
 	                                         source_filter, sink_filter);
 
-	return registerPublishNotificationListener_(zenoh_key, listener);
+	if (isAggregatable(source_filter)) {
+		return registerAggregatableListener_(zenoh_key, source_filter,
+		                                     sink_filter, std::move(listener),
+		                                     std::move(filter));
+	}
+	return registerPublishNotificationListener_(zenoh_key, std::move(listener),
+	                                            std::move(filter));
+}
+
+utils::Expected<ZenohUTransport::ListenHandle, v1::UStatus>
+ZenohUTransport::registerFilteredListener(
+    const v1::UUri& source_filter, ListenCallback&& listener,
+    const AttributeFilter& filter, std::optional<v1::UUri>&& sink_filter) {
+	auto [handle, callable] = connectListener(std::move(listener));
+	auto status =
+	    registerListener_(std::move(callable), source_filter, sink_filter,
+	                      std::make_shared<CompiledAttributeFilter>(filter));
+	if (status.code() != v1::UCode::OK) {
+		return utils::Unexpected<v1::UStatus>(std::move(status));
+	}
+	return std::move(handle);
+}
+
+std::vector<utils::Expected<ZenohUTransport::ListenHandle, v1::UStatus>>
+ZenohUTransport::registerListeners(
+    std::vector<ListenerRegistration>&& registrations) {
+	// Keys are written back to back into one buffer and split afterwards,
+	// rather than each being built in a stream of its own.
+	std::string keys;
+	keys.reserve(registrations.size() * 48);
+	std::vector<size_t> key_ends;
+	key_ends.reserve(registrations.size());
+	for (const auto& registration : registrations) {
+		appendZenohKey(keys, getEntityUri().authority_name(),
+		               registration.source_filter, registration.sink_filter);
+		key_ends.push_back(keys.size());
+	}
+
+	struct Pending {
+		ListenHandle handle;
+		CallableConn listener;
+		std::string zenoh_key;
+		std::optional<SlotSubscriber> subscriber;
+		v1::UStatus status;
+		/// Registered on its own, through an aggregate group.
+		bool aggregatable;
+	};
+	std::vector<Pending> pending;
+	pending.reserve(registrations.size());
+	std::vector<size_t> undeclared;
+
+	for (size_t i = 0; i < registrations.size(); ++i) {
+		auto [handle, listener] =
+		    connectListener(std::move(registrations[i].listener));
+		size_t key_begin = i == 0 ? 0 : key_ends[i - 1];
+		pending.push_back({std::move(handle), std::move(listener),
+		                   keys.substr(key_begin, key_ends[i] - key_begin),
+		                   std::nullopt, v1::UStatus(), false});
+
+		auto& entry = pending.back();
+		const auto& registration = registrations[i];
+		if (isAggregatable(registration.source_filter)) {
+			entry.aggregatable = true;
+			entry.status = registerAggregatableListener_(
+			    entry.zenoh_key, registration.source_filter,
+			    registration.sink_filter, entry.listener, nullptr);
+			continue;
+		}
+
+		entry.subscriber = takeIdleSubscriber(entry.zenoh_key);
+		if (!entry.subscriber) {
+			undeclared.push_back(i);
+		}
+	}
+	spdlog::info("registerListeners: {} listeners, {} to declare",
+	             pending.size(), undeclared.size());
+
+	forEachConcurrently(undeclared.size(), [this, &pending,
+	                                        &undeclared](size_t i) {
+		auto& entry = pending[undeclared[i]];
+		try {
+			entry.subscriber = declareSlotSubscriber(entry.zenoh_key);
+		} catch (const zenoh::ZException& e) {
+			spdlog::error("registerListeners: {}: {}", entry.zenoh_key,
+			              e.what());
+			entry.status = uError(v1::UCode::INTERNAL, e.what());
+		}
+	});
+
+	std::vector<std::pair<CallableConn, RegisteredSubscriber>> registered;
+	registered.reserve(pending.size());
+	for (auto& entry : pending) {
+		if (entry.aggregatable || !entry.subscriber) {
+			continue;
+		}
+		registered.emplace_back(
+		    entry.listener,
+		    attachListener(entry.zenoh_key, entry.listener,
+		                   std::move(*entry.subscriber), nullptr));
+	}
+	subscriber_map_.emplace_all(std::move(registered));
+
+	std::vector<utils::Expected<ListenHandle, v1::UStatus>> results;
+	results.reserve(pending.size());
+	for (auto& entry : pending) {
+		if (entry.status.code() == v1::UCode::OK) {
+			results.emplace_back(std::move(entry.handle));
+		} else {
+			// The handle is dropped with pending, and its cleanup finds
+			// nothing registered.
+			results.emplace_back(
+			    utils::Unexpected<v1::UStatus>(std::move(entry.status)));
+		}
+	}
+	return results;
+}
+
+utils::Expected<PullReceiver, v1::UStatus>
+ZenohUTransport::registerPullListener(const v1::UUri& source_filter,
+                                      std::optional<v1::UUri>&& sink_filter,
+                                      const PullReceiverOptions& options) {
+	std::string zenoh_key = toZenohKeyString(getEntityUri().authority_name(),
+	                                         source_filter, sink_filter);
+	spdlog::info("registerPullListener: {}", zenoh_key);
+
+	auto queue = std::make_shared<PullReceiver::Queue>(options);
+	// Samples are only decoded by the owner, so the listener's filter and
+	// the decoding are not counted here, but expired samples are dropped
+	// from the attributes scanned without decoding, as for other listeners.
+	auto on_sample = [this, gate = callback_gate_, zenoh_key,
+	                  queue](const zenoh::Sample& sample) {
+		CallbackGate::Pass pass(*gate);
+		if (!pass) {
+			return;
+		}
+		settleResponse(sample);
+		StageTracer::Span span(tracer_.get(), "receive", "on_sample");
+		auto* counters = countReceived(zenoh_key, sample);
+		if (ttl_tolerance_) {
+			auto attachment = splitAttachment(sample.get_attachment());
+			auto scanned = attachment
+			                   ? ScannedAttributes::scan(attachment->serialized)
+			                   : std::nullopt;
+			if (scanned &&
+			    isExpired(scanned->id_msb, scanned->ttl, *ttl_tolerance_)) {
+				if (counters) {
+					TransportMetrics::add(counters->expired_receives, 1);
+				}
+				return;
+			}
+		}
+		StageTracer::Span push_span(tracer_.get(), "receive", "push");
+		queue->push(sample.clone());
+	};
+	auto on_drop = [queue]() { queue->close(); };
+	try {
+		PullReceiver receiver(queue, sessionFor(zenoh_key).declare_subscriber(
+		                                 zenoh_key, std::move(on_sample),
+		                                 std::move(on_drop)));
+		if (coalescer_) {
+			std::lock_guard<std::mutex> lock(pull_queues_mutex_);
+			pull_queues_.erase(
+			    std::remove_if(pull_queues_.begin(), pull_queues_.end(),
+			                   [](const auto& entry) {
+				                   return entry.second.expired();
+			                   }),
+			    pull_queues_.end());
+			pull_queues_.emplace_back(zenoh_key, queue);
+		}
+		return receiver;
+	} catch (const zenoh::ZException& e) {
+		return utils::Unexpected<v1::UStatus>(
+		    uError(v1::UCode::INTERNAL, e.what()));
+	}
+}
+
+utils::Expected<EventFdReceiver, v1::UStatus>
+ZenohUTransport::registerEventFdListener(
+    const v1::UUri& source_filter, std::optional<v1::UUri>&& sink_filter,
+    const EventFdReceiverOptions& options) {
+	int event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (event_fd < 0) {
+		return utils::Unexpected<v1::UStatus>(
+		    uError(v1::UCode::INTERNAL, std::strerror(errno)));
+	}
+	auto queue = std::make_shared<EventFdReceiver::Queue>(event_fd, options);
+
+	auto maybe_handle = registerListener(
+	    source_filter,
+	    [queue](const v1::UMessage& message) { queue->push(message); },
+	    std::move(sink_filter));
+	if (!maybe_handle) {
+		return utils::Unexpected<v1::UStatus>(maybe_handle.error());
+	}
+	return EventFdReceiver(std::move(queue), std::move(maybe_handle).value());
 }
 
 void ZenohUTransport::cleanupListener(CallableConn listener) {
-	subscriber_map_.erase(listener);
+	auto registered = subscriber_map_.extract(listener);
+	if (!registered) {
+		return;
+	}
+
+	// Stopping deliveries is local, and only waits for listener calls in
+	// progress. Undeclaring may wait on the network, so it is left to the
+	// reaper.
+	registered->slot->detach();
+
+	if (registered->aggregate) {
+		leaveAggregate(registered->aggregate, listener);
+	}
+	if (!registered->subscriber) {
+		return;
+	}
+
+	// A subscriber handed over to a group drops its samples, so it is not
+	// reused. A subscriber still on its own route keeps it once the
+	// listener has left its group.
+	if (retained_subscribers_ &&
+	    registered->slot->route == ListenerSlot::Route::Own) {
+		auto evicted = retained_subscribers_->park(
+		    registered->zenoh_key,
+		    SlotSubscriber{std::move(registered->slot),
+		                   std::move(*registered->subscriber)});
+		for (auto& idle : evicted) {
+			reaper_.dispose(std::move(idle.subscriber));
+		}
+		return;
+	}
+	reaper_.dispose(std::move(*registered->subscriber));
 }
 
 }  // namespace uprotocol::transport
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Reports the attachment size of each message type in the full and compact
+// formats, and how long encoding and decoding each takes.
+//
+// Usage: AttachmentSizeBenchmark [iterations]
+
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <iomanip>
+#include <iostream>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using Clock = std::chrono::steady_clock;
+using datamodel::builder::UMessageBuilder;
+
+struct ExposeAttachment : public transport::ZenohUTransport {
+	using transport::ZenohUTransport::attachmentToUAttributes;
+	using transport::ZenohUTransport::toZenohKeyString;
+	using transport::ZenohUTransport::uattributesToAttachment;
+};
+
+v1::UUri makeUUri(const std::string& authority, uint32_t ue_id,
+                  uint32_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(authority);
+	uuri.set_ue_id(ue_id);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+struct Format {
+	size_t bytes = 0;
+	double encode_ns = 0;
+	double decode_ns = 0;
+};
+
+Format measure(const v1::UMessage& message, bool compact, size_t iterations) {
+	const auto& attributes = message.attributes();
+	auto key = ExposeAttachment::toZenohKeyString(
+	    "", attributes.source(),
+	    attributes.type() == v1::UMessageType::UMESSAGE_TYPE_PUBLISH
+	        ? std::nullopt
+	        : std::optional<v1::UUri>(attributes.sink()));
+
+	Format format;
+	auto start = Clock::now();
+	for (size_t i = 0; i < iterations; ++i) {
+		auto attachment =
+		    ExposeAttachment::uattributesToAttachment(attributes, compact);
+		format.bytes = zenoh::Bytes::serialize(attachment).size();
+	}
+	format.encode_ns = std::chrono::duration<double, std::nano>(
+	                       Clock::now() - start)
+	                       .count() /
+	                   static_cast<double>(iterations);
+
+	auto bytes = zenoh::Bytes::serialize(
+	    ExposeAttachment::uattributesToAttachment(attributes, compact));
+	start = Clock::now();
+	for (size_t i = 0; i < iterations; ++i) {
+		if (!ExposeAttachment::attachmentToUAttributes(bytes, key)) {
+			std::cerr << "decoding failed" << std::endl;
+			break;
+		}
+	}
+	format.decode_ns = std::chrono::duration<double, std::nano>(
+	                       Clock::now() - start)
+	                       .count() /
+	                   static_cast<double>(iterations);
+	return format;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	size_t iterations = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+	auto topic = makeUUri("vehicle-gateway.example", 0x10AB, 0x8001);
+	auto client = makeUUri("dashboard.example", 0x20CD, 0);
+	auto method = makeUUri("vehicle-gateway.example", 0x10AB, 0x0012);
+	auto request = UMessageBuilder::request(
+	                   v1::UUri(method), v1::UUri(client),
+	                   v1::UPriority::UPRIORITY_CS4, std::chrono::seconds(1))
+	                   .build({"", v1::UPayloadFormat::UPAYLOAD_FORMAT_RAW});
+
+	const std::vector<std::pair<std::string, v1::UMessage>> messages = {
+	    {"publish",
+	     UMessageBuilder::publish(v1::UUri(topic))
+	         .build({"", v1::UPayloadFormat::UPAYLOAD_FORMAT_RAW})},
+	    {"notification",
+	     UMessageBuilder::notification(v1::UUri(topic), v1::UUri(client))
+	         .build({"", v1::UPayloadFormat::UPAYLOAD_FORMAT_RAW})},
+	    {"request", request},
+	    {"response",
+	     UMessageBuilder::response(request).build(
+	         {"", v1::UPayloadFormat::UPAYLOAD_FORMAT_RAW})},
+	};
+
+	std::cout << std::setw(14) << "type" << std::setw(8) << "full B"
+	          << std::setw(11) << "compact B" << std::setw(9) << "saved"
+	          << std::setw(12) << "enc full" << std::setw(12) << "enc comp"
+	          << std::setw(12) << "dec full" << std::setw(12) << "dec comp"
+	          << std::endl;
+	for (const auto& [type, message] : messages) {
+		auto full = measure(message, false, iterations);
+		auto compact = measure(message, true, iterations);
+		double saved = 100.0 * (1.0 - static_cast<double>(compact.bytes) /
+		                                  static_cast<double>(full.bytes));
+		std::cout << std::setw(14) << type << std::setw(8) << full.bytes
+		          << std::setw(11) << compact.bytes << std::fixed
+		          << std::setprecision(1) << std::setw(8) << saved << "%"
+		          << std::setw(10) << full.encode_ns << "ns" << std::setw(10)
+		          << compact.encode_ns << "ns" << std::setw(10)
+		          << full.decode_ns << "ns" << std::setw(10)
+		          << compact.decode_ns << "ns" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures how long it takes to register many listeners, one at a time with
+// registerListener() and all at once with registerListeners().
+//
+// Usage: BulkRegistrationBenchmark [max_listeners]
+
+#include <spdlog/spdlog.h>
+
+#include <iomanip>
+#include <iostream>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using Clock = std::chrono::steady_clock;
+using Registration = transport::ZenohUTransport::ListenerRegistration;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr size_t LISTENER_COUNTS[] = {1000, 10000, 100000};
+// Resource ids per entity, keeping clear of the 0xFFFF wildcard.
+constexpr size_t TOPICS_PER_ENTITY = 0x8000;
+
+v1::UUri makeUUri(size_t index) {
+	v1::UUri uuri;
+	uuri.set_authority_name("bench");
+	uuri.set_ue_id(0x10001 + static_cast<uint32_t>(index / TOPICS_PER_ENTITY));
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(
+	    0x8000 + static_cast<uint32_t>(index % TOPICS_PER_ENTITY));
+	return uuri;
+}
+
+double milliseconds(Clock::duration elapsed) {
+	return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+double registerOneByOne(size_t count) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	spdlog::set_level(spdlog::level::warn);
+
+	std::vector<transport::ZenohUTransport::ListenHandle> handles;
+	handles.reserve(count);
+	auto start = Clock::now();
+	for (size_t i = 0; i < count; ++i) {
+		auto handle = transport->registerListener(
+		    makeUUri(i), [](const v1::UMessage&) {}, {});
+		if (handle) {
+			handles.push_back(std::move(handle).value());
+		}
+	}
+	auto elapsed = Clock::now() - start;
+
+	if (handles.size() < count) {
+		std::cerr << "  only " << handles.size() << "/" << count
+		          << " registered" << std::endl;
+	}
+	return milliseconds(elapsed);
+}
+
+double registerInBulk(size_t count) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	spdlog::set_level(spdlog::level::warn);
+
+	std::vector<Registration> registrations;
+	registrations.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		registrations.push_back(
+		    {makeUUri(i), [](const v1::UMessage&) {}, std::nullopt});
+	}
+
+	auto start = Clock::now();
+	auto results = transport->registerListeners(std::move(registrations));
+	auto elapsed = Clock::now() - start;
+
+	size_t registered = 0;
+	for (const auto& result : results) {
+		registered += result ? 1 : 0;
+	}
+	if (registered < count) {
+		std::cerr << "  only " << registered << "/" << count << " registered"
+		          << std::endl;
+	}
+	return milliseconds(elapsed);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	size_t max_listeners = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+	std::cout << std::setw(10) << "listeners" << std::setw(14) << "single ms"
+	          << std::setw(14) << "bulk ms" << std::setw(10) << "speedup"
+	          << std::endl;
+	for (size_t count : LISTENER_COUNTS) {
+		if (count > max_listeners) {
+			break;
+		}
+		double single = registerOneByOne(count);
+		double bulk = registerInBulk(count);
+		std::cout << std::setw(10) << count << std::fixed
+		          << std::setprecision(1) << std::setw(14) << single
+		          << std::setw(14) << bulk << std::setw(9)
+		          << std::setprecision(2) << (bulk > 0 ? single / bulk : 0)
+		          << "x" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures CS6 publish-to-deliver latency while a second thread saturates
+// the same transport with large CS0 messages, with and without priority
+// lanes.
+//
+// Usage: PriorityLaneBenchmark [probes] [bulk_payload_bytes]
+
+#include <spdlog/spdlog.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t BULK_TOPIC = 0x8000;
+constexpr uint16_t PROBE_TOPIC = 0x8001;
+constexpr auto PROBE_INTERVAL = std::chrono::milliseconds(1);
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name("bench");
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+int64_t nowNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	           Clock::now().time_since_epoch())
+	    .count();
+}
+
+void run(bool lanes, size_t probes, size_t bulk_bytes) {
+	transport::ZenohUTransportOptions options;
+	options.priority_lanes = lanes;
+	options.realtime_lane.batch_size = 2048;
+	auto publisher = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+	auto subscriber = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	// The transport enables per-message debug logging on construction.
+	spdlog::set_level(spdlog::level::warn);
+
+	std::atomic<size_t> bulk_received{0};
+	auto bulk_handle = subscriber->registerListener(
+	    makeUUri(BULK_TOPIC),
+	    [&bulk_received](const v1::UMessage&) { ++bulk_received; }, {});
+
+	std::mutex latencies_mtx;
+	std::vector<int64_t> latencies;
+	latencies.reserve(probes);
+	auto probe_handle = subscriber->registerListener(
+	    makeUUri(PROBE_TOPIC),
+	    [&](const v1::UMessage& message) {
+		    auto latency = nowNs() - std::stoll(message.payload());
+		    std::lock_guard lock(latencies_mtx);
+		    latencies.push_back(latency);
+	    },
+	    {});
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+	std::atomic<bool> stop{false};
+	std::thread bulk([&]() {
+		auto message =
+		    datamodel::builder::UMessageBuilder::publish(makeUUri(BULK_TOPIC))
+		        .withPriority(v1::UPriority::UPRIORITY_CS0)
+		        .build({std::string(bulk_bytes, 'b'),
+		                v1::UPayloadFormat::UPAYLOAD_FORMAT_RAW});
+		while (!stop) {
+			(void)publisher->send(message);
+		}
+	});
+
+	for (size_t i = 0; i < probes; ++i) {
+		auto message =
+		    datamodel::builder::UMessageBuilder::publish(makeUUri(PROBE_TOPIC))
+		        .withPriority(v1::UPriority::UPRIORITY_CS6)
+		        .build({std::to_string(nowNs()),
+		                v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		(void)publisher->send(message);
+		std::this_thread::sleep_for(PROBE_INTERVAL);
+	}
+	stop = true;
+	bulk.join();
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+	std::lock_guard lock(latencies_mtx);
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&latencies](double p) -> double {
+		if (latencies.empty()) {
+			return 0;
+		}
+		auto index = static_cast<size_t>(
+		    p * static_cast<double>(latencies.size() - 1));
+		return static_cast<double>(latencies[index]) / 1000.0;
+	};
+
+	std::cout << std::setw(8) << (lanes ? "on" : "off") << std::setw(10)
+	          << latencies.size() << std::fixed << std::setprecision(1)
+	          << std::setw(12) << percentile(0.5) << std::setw(12)
+	          << percentile(0.99) << std::setw(12) << percentile(0.999)
+	          << std::setw(12) << percentile(1.0) << std::setw(10)
+	          << bulk_received << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	size_t probes = argc > 1 ? std::stoul(argv[1]) : 5000;
+	size_t bulk_bytes = argc > 2 ? std::stoul(argv[2]) : 4 * 1024 * 1024;
+
+	std::cout << "CS6 latency in us under CS0 load of " << bulk_bytes
+	          << "B messages" << std::endl;
+	std::cout << std::setw(8) << "lanes" << std::setw(10) << "probes"
+	          << std::setw(12) << "p50" << std::setw(12) << "p99"
+	          << std::setw(12) << "p99.9" << std::setw(12) << "max"
+	          << std::setw(10) << "bulk" << std::endl;
+	run(false, probes, bulk_bytes);
+	run(true, probes, bulk_bytes);
+	return 0;
+}
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures publish-to-deliver latency with the zenoh runtime threads and the
+// publishing thread pinned to given CPUs. The runtime is process-wide, so
+// each placement is measured in its own process, e.g.:
+//
+//   RuntimePinningBenchmark - -         # no pinning
+//   RuntimePinningBenchmark 2,3 1       # runtime on CPUs 2-3, app on 1
+//   RuntimePinningBenchmark 1 1         # everything on CPU 1
+//
+// Usage: RuntimePinningBenchmark [runtime_cpus|-] [app_cpu|-] [messages]
+
+#include <pthread.h>
+#include <sched.h>
+#include <spdlog/spdlog.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC = 0x8000;
+constexpr auto SEND_INTERVAL = std::chrono::microseconds(200);
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name("bench");
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+int64_t nowNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	           Clock::now().time_since_epoch())
+	    .count();
+}
+
+std::vector<int> parseCpus(const std::string& arg) {
+	std::vector<int> cpus;
+	if (arg == "-") {
+		return cpus;
+	}
+	std::istringstream list(arg);
+	std::string cpu;
+	while (std::getline(list, cpu, ',')) {
+		cpus.push_back(std::stoi(cpu));
+	}
+	return cpus;
+}
+
+void pinCurrentThread(int cpu) {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(static_cast<size_t>(cpu), &set);
+	if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+		std::cerr << "Failed to pin to CPU " << cpu << std::endl;
+	}
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	std::string runtime_arg = argc > 1 ? argv[1] : "-";
+	std::string app_arg = argc > 2 ? argv[2] : "-";
+	size_t messages = argc > 3 ? std::stoul(argv[3]) : 20000;
+
+	transport::ZenohUTransportOptions options;
+	options.runtime.cpu_affinity = parseCpus(runtime_arg);
+	auto publisher = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+	auto subscriber = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	// The transport enables per-message debug logging on construction.
+	spdlog::set_level(spdlog::level::warn);
+
+	if (app_arg != "-") {
+		pinCurrentThread(std::stoi(app_arg));
+	}
+
+	std::mutex latencies_mtx;
+	std::vector<int64_t> latencies;
+	latencies.reserve(messages);
+	auto handle = subscriber->registerListener(
+	    makeUUri(TOPIC),
+	    [&](const v1::UMessage& message) {
+		    auto latency = nowNs() - std::stoll(message.payload());
+		    std::lock_guard lock(latencies_mtx);
+		    latencies.push_back(latency);
+	    },
+	    {});
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+	for (size_t i = 0; i < messages; ++i) {
+		auto message =
+		    datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC))
+		        .build({std::to_string(nowNs()),
+		                v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		(void)publisher->send(message);
+		std::this_thread::sleep_for(SEND_INTERVAL);
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+	std::lock_guard lock(latencies_mtx);
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&latencies](double p) -> double {
+		if (latencies.empty()) {
+			return 0;
+		}
+		auto index = static_cast<size_t>(
+		    p * static_cast<double>(latencies.size() - 1));
+		return static_cast<double>(latencies[index]) / 1000.0;
+	};
+
+	std::cout << "Publish-to-deliver latency in us" << std::endl;
+	std::cout << std::setw(14) << "runtime_cpus" << std::setw(10) << "app_cpu"
+	          << std::setw(10) << "received" << std::setw(12) << "p50"
+	          << std::setw(12) << "p99" << std::setw(12) << "p99.9"
+	          << std::setw(12) << "max" << std::endl;
+	std::cout << std::setw(14) << runtime_arg << std::setw(10) << app_arg
+	          << std::setw(10) << latencies.size() << std::fixed
+	          << std::setprecision(1) << std::setw(12) << percentile(0.5)
+	          << std::setw(12) << percentile(0.99) << std::setw(12)
+	          << percentile(0.999) << std::setw(12) << percentile(1.0)
+	          << std::endl;
+	return 0;
+}
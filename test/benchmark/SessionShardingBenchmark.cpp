@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures publish throughput of one ZenohUTransport as the number of
+// sharded zenoh sessions grows. Each publisher thread owns one topic, so
+// with enough sessions the topics are serialized and sent in parallel.
+//
+// Usage: SessionShardingBenchmark [messages_per_thread] [payload_bytes]
+
+#include <spdlog/spdlog.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr size_t SESSION_COUNTS[] = {1, 2, 4, 8};
+constexpr uint16_t FIRST_TOPIC = 0x8000;
+
+v1::UUri makeUUri(uint32_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name("bench");
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+v1::UUri anyTopic() {
+	v1::UUri uuri = makeUUri(0xFFFF);
+	uuri.set_authority_name("*");
+	return uuri;
+}
+
+double run(size_t session_count, size_t threads, size_t per_thread,
+           size_t payload_bytes) {
+	transport::ZenohUTransportOptions options;
+	options.session_count = session_count;
+	auto publisher = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+	auto subscriber = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	// The transport enables per-message debug logging on construction.
+	spdlog::set_level(spdlog::level::warn);
+
+	std::atomic<size_t> received{0};
+	auto handle = subscriber->registerListener(
+	    anyTopic(), [&received](const v1::UMessage&) { ++received; }, {});
+	if (!handle) {
+		std::cerr << "registerListener failed" << std::endl;
+		return 0;
+	}
+	// Let the subscriber declaration propagate before measuring.
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+	std::vector<std::vector<v1::UMessage>> messages(threads);
+	for (size_t t = 0; t < threads; ++t) {
+		for (size_t i = 0; i < per_thread; ++i) {
+			messages[t].push_back(
+			    datamodel::builder::UMessageBuilder::publish(
+			        makeUUri(FIRST_TOPIC + static_cast<uint32_t>(t)))
+			        .build({std::string(payload_bytes, 'x'),
+			                v1::UPayloadFormat::UPAYLOAD_FORMAT_RAW}));
+		}
+	}
+
+	const size_t total = threads * per_thread;
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> workers;
+	for (size_t t = 0; t < threads; ++t) {
+		workers.emplace_back([&publisher, &messages, t]() {
+			for (const auto& message : messages[t]) {
+				(void)publisher->send(message);
+			}
+		});
+	}
+	for (auto& worker : workers) {
+		worker.join();
+	}
+
+	auto deadline = start + std::chrono::seconds(30);
+	while (received < total && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	std::chrono::duration<double> elapsed =
+	    std::chrono::steady_clock::now() - start;
+
+	if (received < total) {
+		std::cerr << "  only " << received << "/" << total
+		          << " messages received" << std::endl;
+	}
+	return static_cast<double>(received) / elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	size_t per_thread = argc > 1 ? std::stoul(argv[1]) : 100000;
+	size_t payload_bytes = argc > 2 ? std::stoul(argv[2]) : 64;
+	size_t threads = std::max(2U, std::thread::hardware_concurrency());
+
+	std::cout << "threads=" << threads << " messages/thread=" << per_thread
+	          << " payload=" << payload_bytes << "B" << std::endl;
+	std::cout << std::setw(10) << "sessions" << std::setw(16) << "msg/s"
+	          << std::setw(10) << "speedup" << std::endl;
+
+	double baseline = 0;
+	for (size_t sessions : SESSION_COUNTS) {
+		double rate = run(sessions, threads, per_thread, payload_bytes);
+		if (baseline == 0) {
+			baseline = rate;
+		}
+		std::cout << std::setw(10) << sessions << std::setw(16)
+		          << static_cast<uint64_t>(rate) << std::setw(9)
+		          << std::fixed << std::setprecision(2)
+		          << (baseline > 0 ? rate / baseline : 0) << "x" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Compares tracking the deadlines of outstanding RPCs in a TimingWheel with
+// an ordered multimap of deadlines next to a map by serialized id, as
+// CoroTransport does: every call is added, then either answered (removed)
+// or left to expire.
+//
+// Usage: TimingWheelBenchmark [outstanding calls] [rounds]
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "up-transport-zenoh-cpp/TimingWheel.h"
+
+namespace {
+
+using namespace uprotocol;
+using Clock = std::chrono::steady_clock;
+
+struct Id {
+	uint64_t msb;
+	uint64_t lsb;
+
+	bool operator==(const Id& other) const {
+		return msb == other.msb && lsb == other.lsb;
+	}
+};
+
+struct IdHash {
+	size_t operator()(const Id& id) const {
+		return static_cast<size_t>(id.lsb ^ (id.msb * 0x9E3779B97F4A7C15ULL));
+	}
+};
+
+std::string idString(const Id& id) {
+	return std::to_string(id.msb) + "-" + std::to_string(id.lsb);
+}
+
+struct Workload {
+	std::vector<Id> ids;
+	std::vector<Clock::duration> ttls;
+	/// @brief Answered before the deadline, or left to expire.
+	std::vector<bool> answered;
+};
+
+Workload makeWorkload(size_t calls) {
+	std::mt19937_64 random(1);
+	std::uniform_int_distribution<int> ttl_ms(100, 10000);
+	Workload workload;
+	for (size_t i = 0; i < calls; ++i) {
+		workload.ids.push_back({random(), random()});
+		workload.ttls.push_back(std::chrono::milliseconds(ttl_ms(random)));
+		workload.answered.push_back(random() % 10 != 0);
+	}
+	return workload;
+}
+
+// Returns the number of expired calls, so that the work is not optimized
+// away.
+size_t runWheel(const Workload& workload, Clock::time_point start) {
+	transport::TimingWheel<Id, uint32_t, IdHash> wheel(
+	    std::chrono::milliseconds(10), start);
+	for (size_t i = 0; i < workload.ids.size(); ++i) {
+		wheel.insert(workload.ids[i], static_cast<uint32_t>(i),
+		             start + workload.ttls[i]);
+	}
+	for (size_t i = 0; i < workload.ids.size(); ++i) {
+		if (workload.answered[i]) {
+			wheel.erase(workload.ids[i]);
+		}
+	}
+	std::vector<std::pair<Id, uint32_t>> expired;
+	for (auto now = start; !wheel.empty();
+	     now += std::chrono::milliseconds(10)) {
+		wheel.advance(now, expired);
+	}
+	return expired.size();
+}
+
+size_t runOrdered(const Workload& workload, Clock::time_point start) {
+	std::multimap<Clock::time_point, std::string> deadlines;
+	std::unordered_map<std::string,
+	                   std::multimap<Clock::time_point, std::string>::iterator>
+	    pending;
+	for (size_t i = 0; i < workload.ids.size(); ++i) {
+		auto id = idString(workload.ids[i]);
+		auto deadline = deadlines.emplace(start + workload.ttls[i], id);
+		pending.emplace(std::move(id), deadline);
+	}
+	for (size_t i = 0; i < workload.ids.size(); ++i) {
+		if (workload.answered[i]) {
+			auto found = pending.find(idString(workload.ids[i]));
+			deadlines.erase(found->second);
+			pending.erase(found);
+		}
+	}
+	size_t expired = 0;
+	for (auto now = start; !deadlines.empty();
+	     now += std::chrono::milliseconds(10)) {
+		while (!deadlines.empty() && deadlines.begin()->first <= now) {
+			pending.erase(deadlines.begin()->second);
+			deadlines.erase(deadlines.begin());
+			++expired;
+		}
+	}
+	return expired;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	size_t calls = argc > 1 ? std::stoul(argv[1]) : 50000;
+	size_t rounds = argc > 2 ? std::stoul(argv[2]) : 10;
+
+	auto workload = makeWorkload(calls);
+	auto measure = [&workload, rounds](auto&& run) {
+		size_t expired = 0;
+		auto begin = Clock::now();
+		auto start = Clock::time_point() + std::chrono::hours(1);
+		for (size_t round = 0; round < rounds; ++round) {
+			expired = run(workload, start);
+		}
+		auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() -
+		                                                        begin);
+		return std::make_pair(
+		    elapsed.count() /
+		        static_cast<double>(rounds * workload.ids.size()),
+		    expired);
+	};
+
+	auto [wheel_ns, wheel_expired] = measure(runWheel);
+	auto [ordered_ns, ordered_expired] = measure(runOrdered);
+	if (wheel_expired != ordered_expired) {
+		std::cerr << "expired counts differ: " << wheel_expired << " vs "
+		          << ordered_expired << std::endl;
+		return 1;
+	}
+
+	std::cout << calls << " outstanding calls, " << wheel_expired
+	          << " expired" << std::endl
+	          << std::fixed << std::setprecision(1) << std::setw(14)
+	          << "timing wheel" << std::setw(10) << wheel_ns << " ns/call"
+	          << std::endl
+	          << std::setw(14) << "ordered map" << std::setw(10) << ordered_ns
+	          << " ns/call" << std::endl;
+	return 0;
+}
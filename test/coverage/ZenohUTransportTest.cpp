@@ -62,7 +62,6 @@ v1::UUri create_uuri(std::string_view serialized) {
 	    static_cast<std::string>(serialized));
 }
 
-// TODO(sashacmc): config generation
 TEST_F(TestZenohUTransport, ConstructDestroy) {
 	std::cout << ZENOH_CONFIG_FILE << std::endl;
 
@@ -72,12 +71,121 @@ TEST_F(TestZenohUTransport, ConstructDestroy) {
 	    create_uuri(ENTITY_URI_STR), ZENOH_CONFIG_FILE);
 }
 
+TEST_F(TestZenohUTransport, ConstructFromJson5) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    create_uuri(ENTITY_URI_STR),
+	    transport::ZenohConfig::fromJson5(
+	        R"({ mode: "peer", connect: { endpoints: [] } })"));
+}
+
+TEST_F(TestZenohUTransport, ConstructFromBuilder) {
+	auto config = transport::ZenohConfig()
+	                  .mode(transport::ZenohConfig::Mode::Peer)
+	                  .connect({})
+	                  .listen({"tcp/127.0.0.1:0"})
+	                  .multicastScouting(true)
+	                  .batchSize(8192)
+	                  .sharedMemory(false)
+	                  .set("transport/link/tx/lease", "10000");
+
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    create_uuri(ENTITY_URI_STR), config);
+}
+
+TEST_F(TestZenohUTransport, ConstructInvalidJson5Throws) {
+	EXPECT_THROW(transport::ZenohUTransport(
+	                 create_uuri(ENTITY_URI_STR),
+	                 transport::ZenohConfig::fromJson5("{ INVALID: [ }")),
+	             zenoh::ZException);
+}
+
+TEST_F(TestZenohUTransport, ZenohConfigId) {
+	auto base = transport::ZenohConfig::fromFile(ZENOH_CONFIG_FILE);
+	auto tuned = transport::ZenohConfig::fromFile(ZENOH_CONFIG_FILE);
+	tuned.batchSize(4096);
+
+	EXPECT_EQ(base.id(),
+	          transport::ZenohConfig::fromFile(ZENOH_CONFIG_FILE).id());
+	EXPECT_NE(base.id(), tuned.id());
+	EXPECT_NE(base.id(), transport::ZenohConfig().id());
+}
+
+TEST_F(TestZenohUTransport, ZenohConfigEscapesStrings) {
+	auto config = transport::ZenohConfig().connect({"tcp/\"a\"\\\n\x01"});
+	EXPECT_NE(config.id().find(
+	              R"(connect/endpoints=["tcp/\"a\"\\\u000a\u0001"])"),
+	          std::string::npos)
+	    << config.id();
+}
+
+TEST_F(TestZenohUTransport, ZenohConfigIdOfUnresolvablePath) {
+	// Too long for the file system to resolve.
+	std::string path = "/" + std::string(300, 'a');
+	std::string id;
+	EXPECT_NO_THROW(id = transport::ZenohConfig::fromFile(path).id());
+	EXPECT_EQ(id, "file:" + path);
+}
+
+TEST_F(TestZenohUTransport, ConstructShardedSessions) {
+	transport::ZenohUTransportOptions options;
+	options.session_count = 4;
+
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    create_uuri(ENTITY_URI_STR), ZENOH_CONFIG_FILE, options);
+}
+
+TEST_F(TestZenohUTransport, ConstructPriorityLanes) {
+	transport::ZenohUTransportOptions options;
+	options.session_count = 2;
+	options.priority_lanes = true;
+	options.realtime_lane.batch_size = 1024;
+	options.bulk_lane.batch_size = 65535;
+
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    create_uuri(ENTITY_URI_STR), ZENOH_CONFIG_FILE, options);
+}
+
+TEST_F(TestZenohUTransport, ConstructSharedSessions) {
+	transport::ZenohUTransportOptions options;
+	options.share_sessions = true;
+
+	auto before = transport::SessionPool::size();
+	{
+		auto first = std::make_shared<transport::ZenohUTransport>(
+		    create_uuri(ENTITY_URI_STR), ZENOH_CONFIG_FILE, options);
+		auto second = std::make_shared<transport::ZenohUTransport>(
+		    create_uuri("//test0/10002/1/0"), ZENOH_CONFIG_FILE, options);
+		EXPECT_EQ(transport::SessionPool::size(), before + 1);
+
+		options.session_count = 2;
+		auto sharded = std::make_shared<transport::ZenohUTransport>(
+		    create_uuri("//test0/10003/1/0"), ZENOH_CONFIG_FILE, options);
+		EXPECT_EQ(transport::SessionPool::size(), before + 2);
+	}
+	EXPECT_EQ(transport::SessionPool::size(), before);
+}
+
+TEST_F(TestZenohUTransport, ConstructZeroSessionsThrows) {
+	transport::ZenohUTransportOptions options;
+	options.session_count = 0;
+
+	EXPECT_THROW(transport::ZenohUTransport(create_uuri(ENTITY_URI_STR),
+	                                        ZENOH_CONFIG_FILE, options),
+	             std::invalid_argument);
+}
+
 struct ExposeKeyString : public transport::ZenohUTransport {
 	template <typename... Args>
 	static auto toZenohKeyString(Args&&... args) {
 		return transport::ZenohUTransport::toZenohKeyString(
 		    std::forward<Args>(args)...);
 	}
+
+	template <typename... Args>
+	static auto fromZenohKeyString(Args&&... args) {
+		return transport::ZenohUTransport::fromZenohKeyString(
+		    std::forward<Args>(args)...);
+	}
 };
 
 TEST_F(TestZenohUTransport, toZenohKeyString) {
@@ -115,4 +223,54 @@ TEST_F(TestZenohUTransport, toZenohKeyString) {
 	          "up/*/*/*/*/[::1]/*/*/*");
 }
 
+TEST_F(TestZenohUTransport, fromZenohKeyString) {
+	std::vector<std::pair<v1::UUri, std::optional<v1::UUri>>> cases = {
+	    {create_uuri("192.168.1.100", 0x10AB, 3, 0x80CD), std::nullopt},
+	    {create_uuri("192.168.1.100", 0x10AB, 3, 0x80CD),
+	     create_uuri("192.168.1.101", 0x20EF, 4, 0)},
+	    {create_uuri("*", 0xFFFF, 0xFF, 0xFFFF),
+	     create_uuri("[::1]", 0xFFFF, 0xFF, 0xFFFF)},
+	    {create_uuri("my-host1", 0xFFFFFFFE, 0, 0),
+	     create_uuri("my-host2", 0x20EF, 4, 0xB)},
+	};
+	for (const auto& [source, sink] : cases) {
+		auto key = ExposeKeyString::toZenohKeyString("", source, sink);
+		auto parsed = ExposeKeyString::fromZenohKeyString(key);
+		ASSERT_TRUE(parsed) << key;
+		EXPECT_EQ(parsed->source.SerializeAsString(),
+		          source.SerializeAsString())
+		    << key;
+		ASSERT_EQ(parsed->sink.has_value(), sink.has_value()) << key;
+		if (sink) {
+			EXPECT_EQ(parsed->sink->SerializeAsString(),
+			          sink->SerializeAsString())
+			    << key;
+		}
+	}
+
+	// The default authority is filled in by toZenohKeyString().
+	auto parsed = ExposeKeyString::fromZenohKeyString(
+	    ExposeKeyString::toZenohKeyString(
+	        "default", create_uuri("", 0x10AB, 3, 0x80CD), std::nullopt));
+	ASSERT_TRUE(parsed);
+	EXPECT_EQ(parsed->source.authority_name(), "default");
+
+	const std::vector<std::string_view> malformed_keys = {
+	    "",
+	    "up",
+	    "up/host/10AB/3/80CD/{}/{}/{}",
+	    "up/host/10AB/3/80CD/{}/{}/{}/{}/extra",
+	    "down/host/10AB/3/80CD/{}/{}/{}/{}",
+	    "up/host/10ab/3/80CD/{}/{}/{}/{}",
+	    "up/host/10AB/3/123456789/{}/{}/{}/{}",
+	    "up//10AB/3/80CD/{}/{}/{}/{}",
+	    "up/host/10AB//80CD/{}/{}/{}/{}",
+	    "up/host/10AB/3/80CD/{}/20EF/4/0",
+	};
+	for (auto malformed : malformed_keys) {
+		EXPECT_FALSE(ExposeKeyString::fromZenohKeyString(malformed))
+		    << malformed;
+	}
+}
+
 }  // namespace
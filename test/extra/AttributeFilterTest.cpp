@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <mutex>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+using datamodel::builder::UMessageBuilder;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+
+class AttributeFilterTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	AttributeFilterTest() { zenoh::init_logger(); }
+	~AttributeFilterTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+transport::ScannedAttributes scanned(v1::UMessageType type,
+                                     v1::UPriority priority) {
+	transport::ScannedAttributes attributes{};
+	attributes.type = type;
+	attributes.priority = priority;
+	return attributes;
+}
+
+TEST_F(AttributeFilterTest, Matches) {
+	transport::AttributeFilter filter;
+	filter.types = {v1::UMessageType::UMESSAGE_TYPE_PUBLISH};
+	filter.min_priority = v1::UPriority::UPRIORITY_CS2;
+	filter.max_priority = v1::UPriority::UPRIORITY_CS4;
+	filter.authorities = {"b", "a", "b"};
+	transport::CompiledAttributeFilter compiled(filter);
+
+	constexpr auto PUBLISH = v1::UMessageType::UMESSAGE_TYPE_PUBLISH;
+	EXPECT_TRUE(
+	    compiled.matches(scanned(PUBLISH, v1::UPriority::UPRIORITY_CS2), "a"));
+	EXPECT_TRUE(
+	    compiled.matches(scanned(PUBLISH, v1::UPriority::UPRIORITY_CS4), "b"));
+	EXPECT_FALSE(
+	    compiled.matches(scanned(PUBLISH, v1::UPriority::UPRIORITY_CS1), "a"));
+	EXPECT_FALSE(
+	    compiled.matches(scanned(PUBLISH, v1::UPriority::UPRIORITY_CS5), "a"));
+	EXPECT_FALSE(
+	    compiled.matches(scanned(PUBLISH, v1::UPriority::UPRIORITY_CS3), "c"));
+	EXPECT_FALSE(compiled.matches(
+	    scanned(v1::UMessageType::UMESSAGE_TYPE_NOTIFICATION,
+	            v1::UPriority::UPRIORITY_CS3),
+	    "a"));
+
+	// The defaults accept everything.
+	transport::CompiledAttributeFilter any{transport::AttributeFilter{}};
+	EXPECT_TRUE(
+	    any.matches(scanned(v1::UMessageType::UMESSAGE_TYPE_UNSPECIFIED,
+	                        v1::UPriority::UPRIORITY_UNSPECIFIED),
+	                ""));
+}
+
+TEST_F(AttributeFilterTest, DropsBeforeDelivery) {
+	transport::ZenohUTransportOptions options;
+	options.metrics = true;
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+
+	std::mutex mutex;
+	std::vector<v1::UPriority> received;
+	transport::AttributeFilter filter;
+	filter.min_priority = v1::UPriority::UPRIORITY_CS4;
+	filter.authorities = {"test0"};
+	auto handle = transport->registerFilteredListener(
+	    makeUUri(TOPIC_URI),
+	    [&mutex, &received](const v1::UMessage& message) {
+		    std::lock_guard<std::mutex> lock(mutex);
+		    received.push_back(message.attributes().priority());
+	    },
+	    filter);
+	ASSERT_TRUE(handle);
+
+	for (auto priority :
+	     {v1::UPriority::UPRIORITY_CS1, v1::UPriority::UPRIORITY_CS5,
+	      v1::UPriority::UPRIORITY_CS3, v1::UPriority::UPRIORITY_CS4}) {
+		auto message =
+		    UMessageBuilder::publish(makeUUri(TOPIC_URI))
+		        .withPriority(priority)
+		        .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	}
+
+	for (int i = 0; i < 200; ++i) {
+		auto snapshot = transport->metricsSnapshot();
+		if (!snapshot.empty() &&
+		    snapshot.begin()->second.messages_received == 4) {
+			break;
+		}
+		std::this_thread::sleep_for(10ms);
+	}
+	auto snapshot = transport->metricsSnapshot();
+	ASSERT_EQ(snapshot.size(), 1);
+	const auto& topic = snapshot.begin()->second;
+	EXPECT_EQ(topic.messages_received, 4);
+	EXPECT_EQ(topic.messages_filtered, 2);
+	EXPECT_EQ(topic.decode_failures, 0);
+	EXPECT_EQ(topic.listener_invocations, 2);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	EXPECT_EQ(received, (std::vector<v1::UPriority>{
+	                        v1::UPriority::UPRIORITY_CS5,
+	                        v1::UPriority::UPRIORITY_CS4}));
+}
+
+}  // namespace
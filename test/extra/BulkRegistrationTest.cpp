@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+using Registration = transport::ZenohUTransport::ListenerRegistration;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t FIRST_TOPIC = 0x8000;
+constexpr size_t TOPIC_COUNT = 64;
+
+class BulkRegistrationTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	BulkRegistrationTest() { zenoh::init_logger(); }
+	~BulkRegistrationTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+	for (int i = 0; i < 200 && !predicate(); ++i) {
+		std::this_thread::sleep_for(10ms);
+	}
+	return predicate();
+}
+
+TEST_F(BulkRegistrationTest, EveryListenerReceivesItsTopic) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	std::vector<std::atomic<size_t>> received(TOPIC_COUNT);
+	std::vector<Registration> registrations;
+	for (size_t i = 0; i < TOPIC_COUNT; ++i) {
+		registrations.push_back(
+		    {makeUUri(static_cast<uint16_t>(FIRST_TOPIC + i)),
+		     [&received, i](const v1::UMessage&) { ++received[i]; },
+		     std::nullopt});
+	}
+
+	auto results = transport->registerListeners(std::move(registrations));
+	ASSERT_EQ(results.size(), TOPIC_COUNT);
+	for (const auto& result : results) {
+		ASSERT_TRUE(result);
+	}
+
+	for (size_t i = 0; i < TOPIC_COUNT; i += 7) {
+		auto message =
+		    datamodel::builder::UMessageBuilder::publish(
+		        makeUUri(static_cast<uint16_t>(FIRST_TOPIC + i)))
+		        .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	}
+
+	for (size_t i = 0; i < TOPIC_COUNT; ++i) {
+		if (i % 7 == 0) {
+			EXPECT_TRUE(waitFor([&received, i]() { return received[i] > 0; }));
+			EXPECT_EQ(received[i], 1);
+		} else {
+			EXPECT_EQ(received[i], 0);
+		}
+	}
+}
+
+TEST_F(BulkRegistrationTest, RemovingOneHandleKeepsTheOthers) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	// Two listeners on the same topic get a subscriber each, as they would
+	// from registerListener().
+	std::atomic<size_t> first_received{0};
+	std::atomic<size_t> second_received{0};
+	std::vector<Registration> registrations;
+	registrations.push_back(
+	    {makeUUri(FIRST_TOPIC),
+	     [&first_received](const v1::UMessage&) { ++first_received; },
+	     std::nullopt});
+	registrations.push_back(
+	    {makeUUri(FIRST_TOPIC),
+	     [&second_received](const v1::UMessage&) { ++second_received; },
+	     std::nullopt});
+
+	auto results = transport->registerListeners(std::move(registrations));
+	ASSERT_EQ(results.size(), 2);
+	ASSERT_TRUE(results[0]);
+	ASSERT_TRUE(results[1]);
+
+	results[0].value().reset();
+
+	auto message =
+	    datamodel::builder::UMessageBuilder::publish(makeUUri(FIRST_TOPIC))
+	        .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+	EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	EXPECT_TRUE(waitFor([&second_received]() { return second_received > 0; }));
+	EXPECT_EQ(first_received, 0);
+}
+
+TEST_F(BulkRegistrationTest, TakesOverManifestSubscribers) {
+	transport::ZenohUTransportOptions options;
+	options.manifest.emplace();
+	options.manifest->subscriptions.push_back({makeUUri(FIRST_TOPIC), {}});
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+	ASSERT_EQ(transport->warmUpReport().subscribers, 1);
+
+	std::atomic<size_t> received{0};
+	std::vector<Registration> registrations;
+	registrations.push_back(
+	    {makeUUri(FIRST_TOPIC),
+	     [&received](const v1::UMessage&) { ++received; }, std::nullopt});
+	auto results = transport->registerListeners(std::move(registrations));
+	ASSERT_TRUE(results.at(0));
+
+	auto message =
+	    datamodel::builder::UMessageBuilder::publish(makeUUri(FIRST_TOPIC))
+	        .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+	EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	EXPECT_TRUE(waitFor([&received]() { return received > 0; }));
+	EXPECT_EQ(received, 1);
+}
+
+TEST_F(BulkRegistrationTest, EmptyBatch) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	EXPECT_TRUE(transport->registerListeners({}).empty());
+}
+
+}  // namespace
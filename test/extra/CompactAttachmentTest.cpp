@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <mutex>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+using datamodel::builder::UMessageBuilder;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+
+class CompactAttachmentTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	CompactAttachmentTest() { zenoh::init_logger(); }
+	~CompactAttachmentTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+struct ExposeAttachment : public transport::ZenohUTransport {
+	using transport::ZenohUTransport::attachmentToUAttributes;
+	using transport::ZenohUTransport::toZenohKeyString;
+	using transport::ZenohUTransport::uattributesToAttachment;
+};
+
+v1::UUri makeUUri(uint16_t resource_id, uint32_t ue_id = 0x10001) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(ue_id);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+	for (int i = 0; i < 200 && !predicate(); ++i) {
+		std::this_thread::sleep_for(10ms);
+	}
+	return predicate();
+}
+
+TEST_F(CompactAttachmentTest, RoundTripsThroughKey) {
+	auto message =
+	    UMessageBuilder::notification(makeUUri(TOPIC_URI), makeUUri(0, 0x20002))
+	        .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+	const auto& attributes = message.attributes();
+	auto key = ExposeAttachment::toZenohKeyString("", attributes.source(),
+	                                              attributes.sink());
+
+	auto full = zenoh::Bytes::serialize(
+	    ExposeAttachment::uattributesToAttachment(attributes));
+	auto compact = zenoh::Bytes::serialize(
+	    ExposeAttachment::uattributesToAttachment(attributes, true));
+	EXPECT_LT(compact.size(), full.size());
+
+	auto decoded = ExposeAttachment::attachmentToUAttributes(compact, key);
+	ASSERT_TRUE(decoded);
+	EXPECT_EQ(decoded->SerializeAsString(), attributes.SerializeAsString());
+
+	// Without a valid key, the source and sink cannot be recovered.
+	EXPECT_FALSE(ExposeAttachment::attachmentToUAttributes(compact, "up/x"));
+	// Full attachments do not depend on the key.
+	EXPECT_TRUE(ExposeAttachment::attachmentToUAttributes(full, "up/x"));
+}
+
+TEST_F(CompactAttachmentTest, ReceivedByDefaultTransport) {
+	transport::ZenohUTransportOptions options;
+	options.compact_attachments = true;
+	auto sender = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+	auto receiver = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0, 0x20002), ZENOH_CONFIG_FILE);
+
+	std::mutex mutex;
+	std::vector<v1::UMessage> received;
+	auto handle = receiver->registerListener(
+	    makeUUri(TOPIC_URI),
+	    [&mutex, &received](const v1::UMessage& message) {
+		    std::lock_guard<std::mutex> lock(mutex);
+		    received.push_back(message);
+	    },
+	    {});
+	ASSERT_TRUE(handle);
+
+	// An empty source authority is filled in with the sender's default.
+	auto source = makeUUri(TOPIC_URI);
+	source.clear_authority_name();
+	auto message =
+	    UMessageBuilder::publish(std::move(source))
+	        .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+	EXPECT_EQ(sender->send(message).code(), v1::UCode::OK);
+
+	EXPECT_TRUE(waitFor([&mutex, &received]() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return !received.empty();
+	}));
+	std::lock_guard<std::mutex> lock(mutex);
+	ASSERT_EQ(received.size(), 1);
+	EXPECT_EQ(received[0].attributes().source().SerializeAsString(),
+	          makeUUri(TOPIC_URI).SerializeAsString());
+	EXPECT_FALSE(received[0].attributes().has_sink());
+	EXPECT_EQ(received[0].attributes().id().SerializeAsString(),
+	          message.attributes().id().SerializeAsString());
+	EXPECT_EQ(received[0].payload(), "data");
+}
+
+}  // namespace
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <future>
+
+#include "up-transport-zenoh-cpp/CoroTransport.h"
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+constexpr uint16_t METHOD_URI = 0x10;
+
+class CoroTransportTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	CoroTransportTest() { zenoh::init_logger(); }
+	~CoroTransportTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+// Minimal fire-and-forget coroutine type for driving the awaitables.
+struct Detached {
+	struct promise_type {
+		Detached get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+v1::UUri makeUUri(uint16_t resource_id, uint32_t ue_id = 0x10001) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(ue_id);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+std::shared_ptr<transport::ZenohUTransport> getTransport(
+    const v1::UUri& uuri) {
+	return std::make_shared<transport::ZenohUTransport>(uuri,
+	                                                    ZENOH_CONFIG_FILE);
+}
+
+v1::UMessage makeRequest(std::chrono::milliseconds ttl) {
+	return datamodel::builder::UMessageBuilder::request(
+	           makeUUri(METHOD_URI, 0x20002), makeUUri(0),
+	           v1::UPriority::UPRIORITY_CS4, ttl)
+	    .build({"ping", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+}
+
+TEST_F(CoroTransportTest, SendAndStream) {
+	constexpr size_t num_messages = 10;
+	transport::coro::CoroTransport coro(getTransport(makeUUri(0)));
+
+	auto maybe_stream = coro.listen(makeUUri(TOPIC_URI));
+	ASSERT_TRUE(maybe_stream);
+
+	std::promise<std::vector<std::string>> received;
+	auto consumer = [&](transport::coro::MessageStream& stream) -> Detached {
+		std::vector<std::string> payloads;
+		while (payloads.size() < num_messages) {
+			auto message = co_await stream.next();
+			payloads.push_back(message.payload());
+		}
+		received.set_value(std::move(payloads));
+	};
+	consumer(maybe_stream.value());
+
+	auto producer = [&]() -> Detached {
+		for (size_t i = 0; i < num_messages; ++i) {
+			auto status = co_await coro.send(
+			    datamodel::builder::UMessageBuilder::publish(
+			        makeUUri(TOPIC_URI))
+			        .build({std::to_string(i),
+			                v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT}));
+			EXPECT_EQ(status.code(), v1::UCode::OK);
+		}
+	};
+	producer();
+
+	auto future = received.get_future();
+	ASSERT_EQ(future.wait_for(1s), std::future_status::ready);
+	auto payloads = future.get();
+	for (size_t i = 0; i < num_messages; ++i) {
+		EXPECT_EQ(payloads[i], std::to_string(i));
+	}
+}
+
+TEST_F(CoroTransportTest, InvokeMethod) {
+	auto server = getTransport(makeUUri(0, 0x20002));
+	v1::UUri any_source;
+	any_source.set_authority_name("*");
+	any_source.set_ue_id(0xFFFF);
+	any_source.set_ue_version_major(0xFF);
+	any_source.set_resource_id(0xFFFF);
+	auto maybe_server_handle = server->registerListener(
+	    any_source,
+	    [&server](const v1::UMessage& request) {
+		    auto response =
+		        datamodel::builder::UMessageBuilder::response(request).build(
+		            {"pong", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		    EXPECT_EQ(server->send(response).code(), v1::UCode::OK);
+	    },
+	    makeUUri(METHOD_URI, 0x20002));
+	ASSERT_TRUE(maybe_server_handle);
+
+	transport::coro::CoroTransport coro(getTransport(makeUUri(0)));
+
+	std::promise<std::string> result;
+	auto caller = [&]() -> Detached {
+		auto response = co_await coro.invokeMethod(makeRequest(1s));
+		result.set_value(response ? response.value().payload()
+		                          : response.error().message());
+	};
+	caller();
+
+	auto future = result.get_future();
+	ASSERT_EQ(future.wait_for(2s), std::future_status::ready);
+	EXPECT_EQ(future.get(), "pong");
+}
+
+TEST_F(CoroTransportTest, InvokeMethodTimesOut) {
+	transport::coro::CoroTransport coro(getTransport(makeUUri(0)));
+
+	std::promise<v1::UCode> result;
+	auto caller = [&]() -> Detached {
+		auto response = co_await coro.invokeMethod(makeRequest(50ms));
+		result.set_value(response ? v1::UCode::OK : response.error().code());
+	};
+	caller();
+
+	auto future = result.get_future();
+	ASSERT_EQ(future.wait_for(2s), std::future_status::ready);
+	EXPECT_EQ(future.get(), v1::UCode::DEADLINE_EXCEEDED);
+}
+
+}  // namespace
@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+constexpr uint16_t UNDECLARED_TOPIC_URI = 0x8001;
+constexpr size_t NUM_TOPICS = 16;
+
+class DeclarationManifestTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	DeclarationManifestTest() { zenoh::init_logger(); }
+	~DeclarationManifestTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint32_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+transport::DeclarationManifest makeManifest() {
+	transport::DeclarationManifest manifest;
+	for (uint32_t i = 0; i < NUM_TOPICS; ++i) {
+		manifest.publications.push_back(
+		    {makeUUri(TOPIC_URI + 0x100 + i), std::nullopt,
+		     v1::UPriority::UPRIORITY_CS1});
+		manifest.subscriptions.push_back(
+		    {makeUUri(TOPIC_URI + 0x100 + i), std::nullopt});
+	}
+	manifest.publications.push_back(
+	    {makeUUri(TOPIC_URI), std::nullopt, v1::UPriority::UPRIORITY_CS1});
+	manifest.subscriptions.push_back({makeUUri(TOPIC_URI), std::nullopt});
+	return manifest;
+}
+
+TEST_F(DeclarationManifestTest, WarmUpDuringConstruction) {
+	transport::ZenohUTransportOptions options;
+	options.manifest = makeManifest();
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+
+	const auto& report = transport->warmUpReport();
+	EXPECT_EQ(report.publishers, NUM_TOPICS + 1);
+	EXPECT_EQ(report.subscribers, NUM_TOPICS + 1);
+	EXPECT_TRUE(report.failed_keys.empty());
+}
+
+TEST_F(DeclarationManifestTest, PredeclaredAndUndeclaredTopicsDeliver) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	auto report = transport->declareManifest(makeManifest());
+	ASSERT_TRUE(report.failed_keys.empty());
+
+	std::promise<std::string> declared_rx;
+	auto declared_handle = transport->registerListener(
+	    makeUUri(TOPIC_URI),
+	    [&declared_rx](const v1::UMessage& message) {
+		    declared_rx.set_value(message.payload());
+	    },
+	    {});
+	ASSERT_TRUE(declared_handle);
+
+	std::promise<std::string> undeclared_rx;
+	auto undeclared_handle = transport->registerListener(
+	    makeUUri(UNDECLARED_TOPIC_URI),
+	    [&undeclared_rx](const v1::UMessage& message) {
+		    undeclared_rx.set_value(message.payload());
+	    },
+	    {});
+	ASSERT_TRUE(undeclared_handle);
+
+	for (auto topic : {TOPIC_URI, UNDECLARED_TOPIC_URI}) {
+		auto message =
+		    datamodel::builder::UMessageBuilder::publish(makeUUri(topic))
+		        .build({std::to_string(topic),
+		                v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	}
+
+	auto declared_future = declared_rx.get_future();
+	ASSERT_EQ(declared_future.wait_for(1s), std::future_status::ready);
+	EXPECT_EQ(declared_future.get(), std::to_string(TOPIC_URI));
+
+	auto undeclared_future = undeclared_rx.get_future();
+	ASSERT_EQ(undeclared_future.wait_for(1s), std::future_status::ready);
+	EXPECT_EQ(undeclared_future.get(), std::to_string(UNDECLARED_TOPIC_URI));
+}
+
+
+TEST_F(DeclarationManifestTest, DuplicatesDeclaredOnce) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	transport::DeclarationManifest manifest;
+	for (int i = 0; i < 2; ++i) {
+		manifest.publications.push_back(
+		    {makeUUri(TOPIC_URI), std::nullopt, v1::UPriority::UPRIORITY_CS1});
+		manifest.subscriptions.push_back({makeUUri(TOPIC_URI), std::nullopt});
+	}
+
+	auto report = transport->declareManifest(manifest);
+	EXPECT_EQ(report.publishers, 1);
+	EXPECT_EQ(report.subscribers, 1);
+
+	// Already declared by the first call.
+	report = transport->declareManifest(manifest);
+	EXPECT_EQ(report.publishers, 0);
+	EXPECT_EQ(report.subscribers, 0);
+
+	std::atomic<size_t> received{0};
+	auto handle = transport->registerListener(
+	    makeUUri(TOPIC_URI),
+	    [&received](const v1::UMessage&) { ++received; }, {});
+	ASSERT_TRUE(handle);
+
+	auto message =
+	    datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC_URI))
+	        .build({"once", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+	EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	std::this_thread::sleep_for(100ms);
+	EXPECT_EQ(received, 1);
+}
+
+}  // namespace
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+
+class EventFdReceiverTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	EventFdReceiverTest() { zenoh::init_logger(); }
+	~EventFdReceiverTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+std::shared_ptr<transport::ZenohUTransport> getTransport() {
+	return std::make_shared<transport::ZenohUTransport>(makeUUri(0),
+	                                                    ZENOH_CONFIG_FILE);
+}
+
+bool waitReadable(int fd, int timeout_ms) {
+	pollfd pfd{fd, POLLIN, 0};
+	return ::poll(&pfd, 1, timeout_ms) == 1 && (pfd.revents & POLLIN);
+}
+
+TEST_F(EventFdReceiverTest, ReadableWhileQueued) {
+	constexpr size_t num_messages = 10;
+	auto transport = getTransport();
+
+	auto maybe_receiver =
+	    transport->registerEventFdListener(makeUUri(TOPIC_URI));
+	ASSERT_TRUE(maybe_receiver);
+	auto& receiver = maybe_receiver.value();
+
+	EXPECT_FALSE(waitReadable(receiver.fd(), 0));
+
+	for (size_t i = 0; i < num_messages; ++i) {
+		auto message =
+		    datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC_URI))
+		        .build({std::to_string(i),
+		                v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	}
+
+	std::vector<v1::UMessage> batch;
+	while (batch.size() < num_messages && waitReadable(receiver.fd(), 500)) {
+		// Drain in small steps to exercise re-arming of the descriptor.
+		receiver.drain(batch, 3);
+	}
+
+	ASSERT_EQ(batch.size(), num_messages);
+	for (size_t i = 0; i < num_messages; ++i) {
+		EXPECT_EQ(batch[i].payload(), std::to_string(i));
+	}
+	EXPECT_FALSE(waitReadable(receiver.fd(), 0));
+}
+
+
+void publish(transport::UTransport& transport, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		auto message =
+		    datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC_URI))
+		        .build({std::to_string(i),
+		                v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		EXPECT_EQ(transport.send(message).code(), v1::UCode::OK);
+	}
+}
+
+TEST_F(EventFdReceiverTest, BoundedQueueDropsNewest) {
+	auto transport = getTransport();
+
+	transport::EventFdReceiverOptions options;
+	options.capacity = 4;
+	auto maybe_receiver =
+	    transport->registerEventFdListener(makeUUri(TOPIC_URI), {}, options);
+	ASSERT_TRUE(maybe_receiver);
+	auto& receiver = maybe_receiver.value();
+
+	publish(*transport, 10);
+	ASSERT_TRUE(waitReadable(receiver.fd(), 500));
+
+	// Only the transition from empty signals the descriptor.
+	eventfd_t signals = 0;
+	ASSERT_EQ(::eventfd_read(receiver.fd(), &signals), 0);
+	EXPECT_EQ(signals, 1);
+
+	std::vector<v1::UMessage> batch;
+	EXPECT_EQ(receiver.drain(batch), 4);
+	ASSERT_EQ(batch.size(), 4);
+	EXPECT_EQ(batch.front().payload(), "0");
+	EXPECT_EQ(batch.back().payload(), "3");
+	EXPECT_EQ(receiver.dropped(), 6);
+}
+
+TEST_F(EventFdReceiverTest, BoundedQueueDropsOldest) {
+	auto transport = getTransport();
+
+	transport::EventFdReceiverOptions options;
+	options.capacity = 4;
+	options.overflow = transport::EventFdReceiverOptions::Overflow::DropOldest;
+	auto maybe_receiver =
+	    transport->registerEventFdListener(makeUUri(TOPIC_URI), {}, options);
+	ASSERT_TRUE(maybe_receiver);
+	auto& receiver = maybe_receiver.value();
+
+	publish(*transport, 10);
+	ASSERT_TRUE(waitReadable(receiver.fd(), 500));
+
+	std::vector<v1::UMessage> batch;
+	EXPECT_EQ(receiver.drain(batch), 4);
+	ASSERT_EQ(batch.size(), 4);
+	EXPECT_EQ(batch.front().payload(), "6");
+	EXPECT_EQ(batch.back().payload(), "9");
+	EXPECT_EQ(receiver.dropped(), 6);
+	EXPECT_FALSE(waitReadable(receiver.fd(), 0));
+}
+
+}  // namespace
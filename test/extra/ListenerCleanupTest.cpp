@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+
+class ListenerCleanupTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	ListenerCleanupTest() { zenoh::init_logger(); }
+	~ListenerCleanupTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+v1::UMessage makeMessage() {
+	return datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC_URI))
+	    .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+}
+
+TEST_F(ListenerCleanupTest, NoCallsAfterCleanupReturns) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	std::atomic<bool> in_listener{false};
+	std::atomic<bool> entered{false};
+	std::atomic<size_t> calls{0};
+	auto handle = transport->registerListener(
+	    makeUUri(TOPIC_URI),
+	    [&](const v1::UMessage&) {
+		    in_listener = true;
+		    entered = true;
+		    std::this_thread::sleep_for(50ms);
+		    ++calls;
+		    in_listener = false;
+	    },
+	    {});
+	ASSERT_TRUE(handle);
+
+	std::atomic<bool> stop{false};
+	std::thread sender([&transport, &stop]() {
+		while (!stop) {
+			(void)transport->send(makeMessage());
+			std::this_thread::sleep_for(1ms);
+		}
+	});
+
+	while (!entered) {
+		std::this_thread::sleep_for(1ms);
+	}
+	handle.value().reset();
+	EXPECT_FALSE(in_listener);
+	auto calls_at_cleanup = calls.load();
+
+	std::this_thread::sleep_for(100ms);
+	stop = true;
+	sender.join();
+	EXPECT_EQ(calls, calls_at_cleanup);
+}
+
+TEST_F(ListenerCleanupTest, ListenerCanRemoveItself) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	std::optional<transport::UTransport::ListenHandle> handle;
+	std::atomic<size_t> calls{0};
+	auto maybe_handle = transport->registerListener(
+	    makeUUri(TOPIC_URI),
+	    [&handle, &calls](const v1::UMessage&) {
+		    ++calls;
+		    handle.reset();
+	    },
+	    {});
+	ASSERT_TRUE(maybe_handle);
+	handle = std::move(maybe_handle).value();
+
+	EXPECT_EQ(transport->send(makeMessage()).code(), v1::UCode::OK);
+	for (int i = 0; i < 100 && handle; ++i) {
+		std::this_thread::sleep_for(10ms);
+	}
+	EXPECT_FALSE(handle);
+
+	EXPECT_EQ(transport->send(makeMessage()).code(), v1::UCode::OK);
+	std::this_thread::sleep_for(50ms);
+	EXPECT_EQ(calls, 1);
+}
+
+}  // namespace
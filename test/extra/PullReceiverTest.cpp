@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <atomic>
+#include <optional>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+
+class PullReceiverTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	PullReceiverTest() { zenoh::init_logger(); }
+	~PullReceiverTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+std::shared_ptr<transport::ZenohUTransport> getTransport() {
+	return std::make_shared<transport::ZenohUTransport>(makeUUri(0),
+	                                                    ZENOH_CONFIG_FILE);
+}
+
+void publish(transport::UTransport& transport, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		auto message =
+		    datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC_URI))
+		        .build({std::to_string(i),
+		                v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		EXPECT_EQ(transport.send(message).code(), v1::UCode::OK);
+	}
+}
+
+TEST_F(PullReceiverTest, FifoDrainsInOrder) {
+	constexpr size_t num_messages = 25;
+	auto transport = getTransport();
+
+	auto maybe_receiver = transport->registerPullListener(makeUUri(TOPIC_URI));
+	ASSERT_TRUE(maybe_receiver);
+	auto& receiver = maybe_receiver.value();
+
+	publish(*transport, num_messages);
+
+	std::vector<v1::UMessage> batch;
+	while (batch.size() < num_messages) {
+		if (receiver.recvMany(batch, num_messages,
+		                      std::chrono::milliseconds(500)) == 0) {
+			break;
+		}
+	}
+
+	ASSERT_EQ(batch.size(), num_messages);
+	for (size_t i = 0; i < num_messages; ++i) {
+		EXPECT_EQ(batch[i].payload(), std::to_string(i));
+	}
+	EXPECT_FALSE(receiver.tryRecv());
+}
+
+TEST_F(PullReceiverTest, RingKeepsNewest) {
+	constexpr size_t capacity = 4;
+	auto transport = getTransport();
+
+	transport::PullReceiverOptions options;
+	options.channel = transport::PullReceiverOptions::Channel::Ring;
+	options.capacity = capacity;
+	auto maybe_receiver =
+	    transport->registerPullListener(makeUUri(TOPIC_URI), {}, options);
+	ASSERT_TRUE(maybe_receiver);
+	auto& receiver = maybe_receiver.value();
+
+	publish(*transport, 3 * capacity);
+	// Give zenoh time to deliver everything before draining.
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	std::vector<v1::UMessage> batch;
+	EXPECT_EQ(receiver.recvMany(batch, 3 * capacity), capacity);
+	ASSERT_EQ(batch.size(), capacity);
+	EXPECT_EQ(batch.back().payload(), std::to_string(3 * capacity - 1));
+}
+
+TEST_F(PullReceiverTest, RecvManyTimesOut) {
+	auto transport = getTransport();
+
+	auto maybe_receiver = transport->registerPullListener(makeUUri(TOPIC_URI));
+	ASSERT_TRUE(maybe_receiver);
+
+	std::vector<v1::UMessage> batch;
+	auto start = std::chrono::steady_clock::now();
+	EXPECT_EQ(maybe_receiver.value().recvMany(batch, 10,
+	                                          std::chrono::milliseconds(20)),
+	          0);
+	EXPECT_GE(std::chrono::steady_clock::now() - start,
+	          std::chrono::milliseconds(20));
+	EXPECT_TRUE(batch.empty());
+}
+
+
+TEST_F(PullReceiverTest, RecvManyWakesOnArrival) {
+	auto transport = getTransport();
+
+	auto maybe_receiver = transport->registerPullListener(makeUUri(TOPIC_URI));
+	ASSERT_TRUE(maybe_receiver);
+
+	std::thread publisher([&transport]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		publish(*transport, 1);
+	});
+
+	std::vector<v1::UMessage> batch;
+	auto start = std::chrono::steady_clock::now();
+	EXPECT_EQ(maybe_receiver.value().recvMany(batch, 10,
+	                                          std::chrono::seconds(10)),
+	          1);
+	// Woken by the message rather than by the timeout.
+	EXPECT_LT(std::chrono::steady_clock::now() - start,
+	          std::chrono::seconds(5));
+	publisher.join();
+}
+
+TEST_F(PullReceiverTest, DestroyReleasesBlockedDelivery) {
+	auto transport = getTransport();
+
+	transport::PullReceiverOptions options;
+	options.capacity = 1;
+	auto maybe_receiver =
+	    transport->registerPullListener(makeUUri(TOPIC_URI), {}, options);
+	ASSERT_TRUE(maybe_receiver);
+	std::optional<transport::PullReceiver> receiver(
+	    std::move(maybe_receiver).value());
+
+	// The second message blocks delivery until the queue is drained or
+	// the receiver is destroyed.
+	std::atomic<bool> published{false};
+	std::thread publisher([&transport, &published]() {
+		publish(*transport, 2);
+		published = true;
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	receiver.reset();
+	publisher.join();
+	EXPECT_TRUE(published);
+}
+
+}  // namespace
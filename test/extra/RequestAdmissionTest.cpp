@@ -0,0 +1,355 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+using datamodel::builder::UMessageBuilder;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t METHOD_URI = 0x0001;
+
+class RequestAdmissionTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	RequestAdmissionTest() { zenoh::init_logger(); }
+	~RequestAdmissionTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id, uint32_t ue_id = 0x10001) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(ue_id);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+// Holds every handled request until released.
+class Gate {
+public:
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex_);
+		++waiting_;
+		cv_.notify_all();
+		cv_.wait(lock, [this]() { return open_; });
+	}
+
+	bool waitForWaiting(int count) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		return cv_.wait_for(lock, 2s,
+		                    [this, count]() { return waiting_ >= count; });
+	}
+
+	void open() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		open_ = true;
+		cv_.notify_all();
+	}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	int waiting_ = 0;
+	bool open_ = false;
+};
+
+TEST_F(RequestAdmissionTest, ShedsLowestPriority) {
+	transport::RequestAdmissionOptions options;
+	options.worker_threads = 2;
+	options.default_limits.max_concurrent = 1;
+	options.default_limits.queue_capacity = 2;
+
+	Gate gate;
+	std::mutex mutex;
+	std::vector<std::string> events;
+	auto record = [&mutex, &events](std::string event) {
+		std::lock_guard<std::mutex> lock(mutex);
+		events.push_back(std::move(event));
+	};
+	auto request = [&record](const std::string& name, v1::UPriority priority,
+	                         std::function<void()> handle = {}) {
+		transport::RequestAdmission::Request request;
+		request.priority = priority;
+		request.handle = [&record, name, handle]() {
+			if (handle) {
+				handle();
+			}
+			record("handled " + name);
+		};
+		request.reject = [&record, name]() { record("rejected " + name); };
+		request.expire = [&record, name]() { record("expired " + name); };
+		return request;
+	};
+
+	{
+		transport::RequestAdmission admission(options);
+		auto method = makeUUri(METHOD_URI);
+		admission.submit(method,
+		                 request("first", v1::UPriority::UPRIORITY_CS4,
+		                         [&gate]() { gate.wait(); }));
+		ASSERT_TRUE(gate.waitForWaiting(1));
+
+		admission.submit(method, request("cs1", v1::UPriority::UPRIORITY_CS1));
+		admission.submit(method, request("cs3", v1::UPriority::UPRIORITY_CS3));
+		// The queue is full: cs1 makes room for cs5, and cs0 is turned away.
+		admission.submit(method, request("cs5", v1::UPriority::UPRIORITY_CS5));
+		admission.submit(method, request("cs0", v1::UPriority::UPRIORITY_CS0));
+
+		auto stale = request("stale", v1::UPriority::UPRIORITY_CS6);
+		stale.deadline = std::chrono::system_clock::now() - 1ms;
+		admission.submit(method, std::move(stale));
+		auto expiring = request("expiring", v1::UPriority::UPRIORITY_CS6);
+		expiring.deadline = std::chrono::system_clock::now() + 10ms;
+		admission.submit(method, std::move(expiring));
+
+		// Other methods have slots of their own.
+		admission.submit(makeUUri(METHOD_URI + 1),
+		                 request("other", v1::UPriority::UPRIORITY_CS0));
+		for (int i = 0; i < 200; ++i) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!events.empty() && events.back() == "handled other") {
+				break;
+			}
+			std::this_thread::sleep_for(10ms);
+		}
+
+		std::this_thread::sleep_for(20ms);
+		gate.open();
+		for (int i = 0; i < 200; ++i) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (events.size() == 8) {
+				break;
+			}
+			std::this_thread::sleep_for(10ms);
+		}
+	}
+
+	// "expiring" pushed "cs3" out of the full queue before it expired.
+	std::lock_guard<std::mutex> lock(mutex);
+	EXPECT_EQ(events, (std::vector<std::string>{
+	                      "rejected cs1", "rejected cs0", "expired stale",
+	                      "rejected cs3", "handled other", "handled first",
+	                      "expired expiring", "handled cs5"}));
+}
+
+TEST_F(RequestAdmissionTest, RejectsWithResponse) {
+	transport::ZenohUTransportOptions options;
+	options.metrics = true;
+	options.request_admission.worker_threads = 1;
+	options.request_admission.default_limits.queue_capacity = 0;
+	auto server = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+	auto client = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0, 0x20002), ZENOH_CONFIG_FILE);
+
+	Gate gate;
+	auto method = makeUUri(METHOD_URI);
+	auto server_handle = server->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF), [&gate](const v1::UMessage&) { gate.wait(); },
+	    makeUUri(METHOD_URI));
+	ASSERT_TRUE(server_handle);
+
+	std::mutex mutex;
+	std::vector<v1::UMessage> responses;
+	auto client_handle = client->registerListener(
+	    makeUUri(METHOD_URI),
+	    [&mutex, &responses](const v1::UMessage& message) {
+		    std::lock_guard<std::mutex> lock(mutex);
+		    responses.push_back(message);
+	    },
+	    makeUUri(0, 0x20002));
+	ASSERT_TRUE(client_handle);
+
+	auto first = UMessageBuilder::request(makeUUri(METHOD_URI),
+	                                      makeUUri(0, 0x20002),
+	                                      v1::UPriority::UPRIORITY_CS4, 10s)
+	                 .build();
+	EXPECT_EQ(client->send(first).code(), v1::UCode::OK);
+	ASSERT_TRUE(gate.waitForWaiting(1));
+
+	auto second = UMessageBuilder::request(makeUUri(METHOD_URI),
+	                                       makeUUri(0, 0x20002),
+	                                       v1::UPriority::UPRIORITY_CS4, 10s)
+	                  .build();
+	EXPECT_EQ(client->send(second).code(), v1::UCode::OK);
+
+	for (int i = 0; i < 200; ++i) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!responses.empty()) {
+			break;
+		}
+		std::this_thread::sleep_for(10ms);
+	}
+	gate.open();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	ASSERT_EQ(responses.size(), 1);
+	EXPECT_EQ(responses[0].attributes().commstatus(),
+	          v1::UCode::RESOURCE_EXHAUSTED);
+	EXPECT_EQ(responses[0].attributes().reqid().SerializeAsString(),
+	          second.attributes().id().SerializeAsString());
+
+	uint64_t shed = 0;
+	for (const auto& [key, topic] : server->metricsSnapshot()) {
+		shed += topic.requests_shed;
+	}
+	EXPECT_EQ(shed, 1);
+}
+
+TEST_F(RequestAdmissionTest, RemovedListenerIsNotCalled) {
+	transport::ZenohUTransportOptions options;
+	options.request_admission.worker_threads = 1;
+	options.request_admission.default_limits.max_concurrent = 1;
+	options.request_admission.default_limits.queue_capacity = 8;
+	auto server = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+	auto client = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0, 0x20002), ZENOH_CONFIG_FILE);
+
+	Gate gate;
+	std::atomic<int> handled{0};
+	std::atomic<bool> removed{false};
+	std::atomic<int> called_after_removal{0};
+	auto server_handle = server->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF),
+	    [&gate, &handled, &removed,
+	     &called_after_removal](const v1::UMessage&) {
+		    if (removed) {
+			    ++called_after_removal;
+		    }
+		    ++handled;
+		    gate.wait();
+	    },
+	    makeUUri(METHOD_URI));
+	ASSERT_TRUE(server_handle);
+
+	for (int i = 0; i < 3; ++i) {
+		auto request = UMessageBuilder::request(
+		                   makeUUri(METHOD_URI), makeUUri(0, 0x20002),
+		                   v1::UPriority::UPRIORITY_CS4, 10s)
+		                   .build();
+		EXPECT_EQ(client->send(request).code(), v1::UCode::OK);
+	}
+	// One request is handled, and the others are queued behind it.
+	ASSERT_TRUE(gate.waitForWaiting(1));
+
+	std::thread remover([&server_handle, &removed]() {
+		server_handle.value().reset();
+		removed = true;
+	});
+	// Removing the listener waits for the call in progress.
+	std::this_thread::sleep_for(50ms);
+	EXPECT_FALSE(removed);
+
+	gate.open();
+	remover.join();
+	EXPECT_TRUE(removed);
+
+	// The queued requests are dropped rather than handled.
+	std::this_thread::sleep_for(100ms);
+	EXPECT_EQ(handled, 1);
+	EXPECT_EQ(called_after_removal, 0);
+}
+
+TEST_F(RequestAdmissionTest, OnlyMethodServersAreAdmitted) {
+	transport::ZenohUTransportOptions options;
+	options.metrics = true;
+	options.request_admission.worker_threads = 1;
+	options.request_admission.default_limits.queue_capacity = 0;
+	auto server = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+	auto client = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0, 0x20002), ZENOH_CONFIG_FILE);
+
+	Gate gate;
+	auto server_handle = server->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF), [&gate](const v1::UMessage&) { gate.wait(); },
+	    makeUUri(METHOD_URI));
+	ASSERT_TRUE(server_handle);
+	// Also sees the responses, which are left out.
+	std::atomic<int> monitored{0};
+	auto monitor_handle = server->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF),
+	    [&monitored](const v1::UMessage& message) {
+		    if (message.attributes().type() ==
+		        v1::UMessageType::UMESSAGE_TYPE_REQUEST) {
+			    ++monitored;
+		    }
+	    },
+	    makeUUri(0xFFFF, 0xFFFF));
+	ASSERT_TRUE(monitor_handle);
+
+	std::atomic<int> responses{0};
+	auto client_handle = client->registerListener(
+	    makeUUri(METHOD_URI),
+	    [&responses](const v1::UMessage&) { ++responses; },
+	    makeUUri(0, 0x20002));
+	ASSERT_TRUE(client_handle);
+
+	for (int i = 0; i < 2; ++i) {
+		auto request = UMessageBuilder::request(
+		                   makeUUri(METHOD_URI), makeUUri(0, 0x20002),
+		                   v1::UPriority::UPRIORITY_CS4, 10s)
+		                   .build();
+		EXPECT_EQ(client->send(request).code(), v1::UCode::OK);
+		if (i == 0) {
+			ASSERT_TRUE(gate.waitForWaiting(1));
+		}
+	}
+
+	// The monitoring listener sees both requests, though the method is
+	// busy, and only the method server's turns the second one away.
+	for (int i = 0; i < 200 && responses == 0; ++i) {
+		std::this_thread::sleep_for(10ms);
+	}
+	std::this_thread::sleep_for(50ms);
+	EXPECT_EQ(monitored, 2);
+	EXPECT_EQ(responses, 1);
+	gate.open();
+
+	// The admitted call is timed like any other, next to the monitoring
+	// listener's calls for both requests and the response.
+	uint64_t invocations = 0;
+	for (int i = 0; i < 200 && invocations < 4; ++i) {
+		std::this_thread::sleep_for(10ms);
+		invocations = 0;
+		for (const auto& [key, topic] : server->metricsSnapshot()) {
+			invocations += topic.listener_invocations;
+		}
+	}
+	EXPECT_EQ(invocations, 4);
+}
+
+}  // namespace
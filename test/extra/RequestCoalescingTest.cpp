@@ -0,0 +1,361 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+using datamodel::builder::UMessageBuilder;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t METHOD_URI = 0x0001;
+
+class RequestCoalescingTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	RequestCoalescingTest() { zenoh::init_logger(); }
+	~RequestCoalescingTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id, uint32_t ue_id = 0x10001) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(ue_id);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+v1::UMessage makeRequest(const std::string& payload) {
+	return UMessageBuilder::request(makeUUri(METHOD_URI), makeUUri(0, 0x20002),
+	                                v1::UPriority::UPRIORITY_CS4, 10s)
+	    .build({payload, v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+}
+
+template <typename Predicate>
+bool waitFor(std::mutex& mutex, Predicate predicate) {
+	for (int i = 0; i < 200; ++i) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (predicate()) {
+				return true;
+			}
+		}
+		std::this_thread::sleep_for(10ms);
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	return predicate();
+}
+
+TEST_F(RequestCoalescingTest, SharesIdenticalRequests) {
+	transport::ZenohUTransportOptions options;
+	options.metrics = true;
+	options.request_coalescing.methods = {makeUUri(METHOD_URI)};
+	auto client = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0, 0x20002), ZENOH_CONFIG_FILE, options);
+	auto server = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	// Requests are held, and answered later, so that they stay in flight.
+	std::mutex mutex;
+	std::vector<v1::UMessage> served;
+	auto server_handle = server->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF),
+	    [&mutex, &served](const v1::UMessage& request) {
+		    std::lock_guard<std::mutex> lock(mutex);
+		    served.push_back(request);
+	    },
+	    makeUUri(METHOD_URI));
+	ASSERT_TRUE(server_handle);
+
+	std::vector<v1::UMessage> responses;
+	auto client_handle = client->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF),
+	    [&mutex, &responses](const v1::UMessage& response) {
+		    std::lock_guard<std::mutex> lock(mutex);
+		    responses.push_back(response);
+	    },
+	    makeUUri(0, 0x20002));
+	ASSERT_TRUE(client_handle);
+
+	std::vector<v1::UMessage> requests = {
+	    makeRequest("a"), makeRequest("a"), makeRequest("b"),
+	    makeRequest("a")};
+	for (const auto& request : requests) {
+		EXPECT_EQ(client->send(request).code(), v1::UCode::OK);
+	}
+	ASSERT_TRUE(waitFor(mutex, [&served]() { return served.size() == 2; }));
+	std::this_thread::sleep_for(50ms);
+
+	std::vector<v1::UMessage> to_answer;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		ASSERT_EQ(served.size(), 2);
+		EXPECT_EQ(served[0].payload(), "a");
+		EXPECT_EQ(served[1].payload(), "b");
+		to_answer = served;
+	}
+	for (const auto& request : to_answer) {
+		auto response = UMessageBuilder::response(request).build(
+		    {"re:" + request.payload(),
+		     v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		EXPECT_EQ(server->send(response).code(), v1::UCode::OK);
+	}
+	ASSERT_TRUE(
+	    waitFor(mutex, [&responses]() { return responses.size() == 4; }));
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (const auto& request : requests) {
+			auto answer = std::find_if(
+			    responses.begin(), responses.end(),
+			    [&request](const v1::UMessage& response) {
+				    return response.attributes().reqid().SerializeAsString() ==
+				           request.attributes().id().SerializeAsString();
+			    });
+			ASSERT_NE(answer, responses.end());
+			EXPECT_EQ(answer->payload(), "re:" + request.payload());
+		}
+	}
+
+	uint64_t coalesced = 0;
+	for (const auto& [key, topic] : client->metricsSnapshot()) {
+		coalesced += topic.requests_coalesced;
+	}
+	EXPECT_EQ(coalesced, 2);
+
+	// Once answered, the next identical request is sent again.
+	EXPECT_EQ(client->send(makeRequest("a")).code(), v1::UCode::OK);
+	EXPECT_TRUE(waitFor(mutex, [&served]() { return served.size() == 3; }));
+}
+
+TEST_F(RequestCoalescingTest, CopiesReachEveryListener) {
+	transport::ZenohUTransportOptions options;
+	options.request_coalescing.methods = {makeUUri(METHOD_URI)};
+	options.rpc_deadlines.on_expired =
+	    [](std::vector<transport::ExpiredRequest>&&) {};
+	auto client = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0, 0x20002), ZENOH_CONFIG_FILE, options);
+	auto server = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	std::mutex mutex;
+	std::vector<v1::UMessage> served;
+	auto server_handle = server->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF),
+	    [&mutex, &served](const v1::UMessage& request) {
+		    std::lock_guard<std::mutex> lock(mutex);
+		    served.push_back(request);
+	    },
+	    makeUUri(METHOD_URI));
+	ASSERT_TRUE(server_handle);
+
+	// Two callback listeners and a pull listener for the same responses.
+	std::vector<std::vector<v1::UMessage>> responses(2);
+	std::vector<transport::ZenohUTransport::ListenHandle> client_handles;
+	for (size_t i = 0; i < responses.size(); ++i) {
+		auto handle = client->registerListener(
+		    makeUUri(METHOD_URI),
+		    [&mutex, &responses, i](const v1::UMessage& response) {
+			    std::lock_guard<std::mutex> lock(mutex);
+			    responses[i].push_back(response);
+		    },
+		    makeUUri(0, 0x20002));
+		ASSERT_TRUE(handle);
+		client_handles.push_back(std::move(handle).value());
+	}
+	auto pull = client->registerPullListener(makeUUri(METHOD_URI),
+	                                         makeUUri(0, 0x20002));
+	ASSERT_TRUE(pull);
+
+	auto leader = makeRequest("a");
+	auto follower = makeRequest("a");
+	EXPECT_EQ(client->send(leader).code(), v1::UCode::OK);
+	EXPECT_EQ(client->send(follower).code(), v1::UCode::OK);
+	ASSERT_TRUE(waitFor(mutex, [&served]() { return served.size() == 1; }));
+	EXPECT_EQ(client->pendingRequests(), 2);
+
+	auto response = UMessageBuilder::response(leader).build(
+	    {"re:a", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+	EXPECT_EQ(server->send(response).code(), v1::UCode::OK);
+
+	auto answered = [&leader, &follower](
+	                    const std::vector<v1::UMessage>& received) {
+		std::vector<std::string> request_ids;
+		for (const auto& message : received) {
+			request_ids.push_back(
+			    message.attributes().reqid().SerializeAsString());
+		}
+		std::sort(request_ids.begin(), request_ids.end());
+		std::vector<std::string> expected = {
+		    leader.attributes().id().SerializeAsString(),
+		    follower.attributes().id().SerializeAsString()};
+		std::sort(expected.begin(), expected.end());
+		return request_ids == expected;
+	};
+	ASSERT_TRUE(waitFor(mutex, [&responses]() {
+		return responses[0].size() == 2 && responses[1].size() == 2;
+	}));
+	std::this_thread::sleep_for(50ms);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		EXPECT_TRUE(answered(responses[0]));
+		EXPECT_TRUE(answered(responses[1]));
+	}
+	std::vector<v1::UMessage> pulled;
+	pull->recvMany(pulled, 8, 1s);
+	EXPECT_TRUE(answered(pulled));
+	EXPECT_EQ(client->pendingRequests(), 0);
+}
+
+TEST_F(RequestCoalescingTest, PullListenersLandFlights) {
+	transport::ZenohUTransportOptions options;
+	options.request_coalescing.methods = {makeUUri(METHOD_URI)};
+	auto client = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0, 0x20002), ZENOH_CONFIG_FILE, options);
+	auto server = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	std::mutex mutex;
+	std::vector<v1::UMessage> served;
+	auto server_handle = server->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF),
+	    [&mutex, &served](const v1::UMessage& request) {
+		    std::lock_guard<std::mutex> lock(mutex);
+		    served.push_back(request);
+	    },
+	    makeUUri(METHOD_URI));
+	ASSERT_TRUE(server_handle);
+	auto pull = client->registerPullListener(makeUUri(METHOD_URI),
+	                                         makeUUri(0, 0x20002));
+	ASSERT_TRUE(pull);
+
+	auto request = makeRequest("a");
+	EXPECT_EQ(client->send(request).code(), v1::UCode::OK);
+	ASSERT_TRUE(waitFor(mutex, [&served]() { return served.size() == 1; }));
+	EXPECT_EQ(server
+	              ->send(UMessageBuilder::response(request).build(
+	                  {"re:a", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT}))
+	              .code(),
+	          v1::UCode::OK);
+	std::vector<v1::UMessage> pulled;
+	EXPECT_EQ(pull->recvMany(pulled, 8, 1s), 1);
+
+	// The flight landed, so the next identical request is sent again.
+	EXPECT_EQ(client->send(makeRequest("a")).code(), v1::UCode::OK);
+	EXPECT_TRUE(waitFor(mutex, [&served]() { return served.size() == 2; }));
+}
+
+TEST_F(RequestCoalescingTest, RequestsWithoutTtlAreSent) {
+	transport::RequestCoalescer coalescer({makeUUri(METHOD_URI)});
+
+	// Their flights would never end if the response were lost.
+	for (int i = 0; i < 2; ++i) {
+		auto request = makeRequest("a");
+		request.mutable_attributes()->set_ttl(0);
+		EXPECT_FALSE(coalescer.join(request.attributes(), request.payload()));
+	}
+
+	auto leader = makeRequest("a");
+	EXPECT_FALSE(coalescer.join(leader.attributes(), leader.payload()));
+	auto follower = makeRequest("a");
+	EXPECT_TRUE(coalescer.join(follower.attributes(), follower.payload()));
+}
+
+TEST_F(RequestCoalescingTest, DestroyedWhileRetainedSubscriberReceives) {
+	transport::ZenohUTransportOptions options;
+	options.request_coalescing.methods = {makeUUri(METHOD_URI)};
+	options.retention.capacity = 4;
+	options.retention.grace_period = 10s;
+	auto client = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0, 0x20002), ZENOH_CONFIG_FILE, options);
+	auto server = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	std::mutex mutex;
+	std::vector<v1::UMessage> served;
+	auto server_handle = server->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF),
+	    [&mutex, &served](const v1::UMessage& request) {
+		    std::lock_guard<std::mutex> lock(mutex);
+		    served.push_back(request);
+	    },
+	    makeUUri(METHOD_URI));
+	ASSERT_TRUE(server_handle);
+
+	// The response listener is removed again, so that its subscriber is
+	// retained, and still receives the responses below.
+	auto client_handle = client->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF), [](const v1::UMessage&) {},
+	    makeUUri(0, 0x20002));
+	ASSERT_TRUE(client_handle);
+	client_handle.value().reset();
+	ASSERT_EQ(client->retentionStats().retained, 1);
+
+	// Its queue stays listed, for the retained subscriber to look through
+	// for copies.
+	{
+		auto pull = client->registerPullListener(makeUUri(0xFFFF, 0xFFFF),
+		                                         makeUUri(0, 0x20003));
+		ASSERT_TRUE(pull);
+	}
+
+	// Every flight has a follower, so each response is copied.
+	constexpr size_t FLIGHTS = 200;
+	for (size_t i = 0; i < FLIGHTS; ++i) {
+		EXPECT_EQ(client->send(makeRequest(std::to_string(i))).code(),
+		          v1::UCode::OK);
+		EXPECT_EQ(client->send(makeRequest(std::to_string(i))).code(),
+		          v1::UCode::OK);
+	}
+	ASSERT_TRUE(
+	    waitFor(mutex, [&served]() { return served.size() == FLIGHTS; }));
+
+	std::atomic<bool> answering{false};
+	std::thread responder([&]() {
+		for (const auto& request : served) {
+			answering = true;
+			auto response = UMessageBuilder::response(request).build(
+			    {"re:" + request.payload(),
+			     v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+			EXPECT_EQ(server->send(response).code(), v1::UCode::OK);
+		}
+	});
+	while (!answering) {
+		std::this_thread::yield();
+	}
+	client.reset();
+	responder.join();
+}
+
+}  // namespace
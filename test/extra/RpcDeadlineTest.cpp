@@ -0,0 +1,211 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/TimingWheel.h"
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+using datamodel::builder::UMessageBuilder;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t METHOD_URI = 0x0001;
+
+class RpcDeadlineTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	RpcDeadlineTest() { zenoh::init_logger(); }
+	~RpcDeadlineTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id, uint32_t ue_id = 0x10001) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(ue_id);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+TEST_F(RpcDeadlineTest, WheelMatchesOrderedDeadlines) {
+	const auto start = Clock::time_point() + 1h;
+	transport::TimingWheel<uint32_t, uint32_t> wheel(1ms, start);
+	std::map<uint32_t, Clock::time_point> reference;
+
+	std::mt19937 random(1);
+	// Up to 2^26 ticks ahead, so all four wheels are used.
+	std::uniform_int_distribution<int64_t> delay(0, 1 << 26);
+	std::uniform_int_distribution<int> scale(0, 26);
+	auto now = start;
+	uint32_t next_key = 0;
+	for (int round = 0; round < 2000; ++round) {
+		for (int i = 0; i < 20; ++i) {
+			// Spread delays evenly over the orders of magnitude.
+			auto deadline = now + std::chrono::microseconds(
+			                          delay(random) >> scale(random));
+			ASSERT_TRUE(wheel.insert(next_key, next_key, deadline));
+			reference.emplace(next_key++, deadline);
+		}
+		for (int i = 0; i < 5 && !reference.empty(); ++i) {
+			auto erased = reference.begin();
+			std::advance(erased,
+			             static_cast<long>(random() % reference.size()));
+			EXPECT_EQ(wheel.erase(erased->first), erased->first);
+			reference.erase(erased);
+		}
+		EXPECT_FALSE(wheel.erase(next_key));
+
+		now += std::chrono::microseconds(delay(random) >> scale(random));
+		std::vector<std::pair<uint32_t, uint32_t>> expired;
+		wheel.advance(now, expired);
+		for (const auto& [key, value] : expired) {
+			EXPECT_EQ(key, value);
+			auto found = reference.find(key);
+			ASSERT_NE(found, reference.end());
+			// Never early, and never more than a tick late.
+			EXPECT_LE(found->second, now);
+			reference.erase(found);
+		}
+		// Deadlines inserted at a tick already advanced to expire on the
+		// next one.
+		auto last_tick =
+		    start +
+		    std::chrono::floor<std::chrono::milliseconds>(now - start);
+		for (const auto& [key, deadline] : reference) {
+			ASSERT_GT(deadline, last_tick - 1ms) << "key " << key;
+		}
+		ASSERT_EQ(wheel.size(), reference.size());
+	}
+}
+
+TEST_F(RpcDeadlineTest, WheelExpiresOnTheTick) {
+	const auto start = Clock::time_point() + 1h;
+	transport::TimingWheel<uint32_t, Clock::time_point> wheel(1ms, start);
+
+	// Across the first two wheels and into the third.
+	constexpr int TICKS = (1 << 16) + 1000;
+	std::mt19937 random(2);
+	std::uniform_int_distribution<int64_t> delay(0, TICKS * 1000LL);
+	for (uint32_t key = 0; key < 5000; ++key) {
+		auto deadline = start + std::chrono::microseconds(delay(random));
+		ASSERT_TRUE(wheel.insert(key, deadline, deadline));
+	}
+
+	std::vector<std::pair<uint32_t, Clock::time_point>> expired;
+	for (int tick = 1; tick <= TICKS + 1; ++tick) {
+		auto now = start + std::chrono::milliseconds(tick);
+		wheel.advance(now, expired);
+		for (const auto& [key, deadline] : expired) {
+			// Deadlines are rounded up to the next tick.
+			ASSERT_LE(deadline, now) << "key " << key;
+			ASSERT_GT(deadline, now - 1ms) << "key " << key;
+		}
+		expired.clear();
+	}
+	EXPECT_TRUE(wheel.empty());
+}
+
+TEST_F(RpcDeadlineTest, ReportsUnansweredRequests) {
+	std::mutex mutex;
+	std::vector<std::vector<transport::ExpiredRequest>> batches;
+	transport::ZenohUTransportOptions options;
+	options.rpc_deadlines.on_expired =
+	    [&mutex, &batches](std::vector<transport::ExpiredRequest>&& expired) {
+		    std::lock_guard<std::mutex> lock(mutex);
+		    batches.push_back(std::move(expired));
+	    };
+	auto client = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0, 0x20002), ZENOH_CONFIG_FILE, options);
+	auto server = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	// Answers only the requests with a payload.
+	auto server_handle = server->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF),
+	    [&server](const v1::UMessage& request) {
+		    if (!request.payload().empty()) {
+			    auto response = UMessageBuilder::response(request).build(
+			        {"", v1::UPayloadFormat::UPAYLOAD_FORMAT_RAW});
+			    EXPECT_EQ(server->send(response).code(), v1::UCode::OK);
+		    }
+	    },
+	    makeUUri(METHOD_URI));
+	ASSERT_TRUE(server_handle);
+	auto client_handle = client->registerListener(
+	    makeUUri(0xFFFF, 0xFFFF), [](const v1::UMessage&) {},
+	    makeUUri(0, 0x20002));
+	ASSERT_TRUE(client_handle);
+
+	std::vector<v1::UMessage> unanswered;
+	for (int i = 0; i < 10; ++i) {
+		auto request = UMessageBuilder::request(makeUUri(METHOD_URI),
+		                                        makeUUri(0, 0x20002),
+		                                        v1::UPriority::UPRIORITY_CS4,
+		                                        50ms);
+		if (i % 2 == 0) {
+			unanswered.push_back(request.build());
+			EXPECT_EQ(client->send(unanswered.back()).code(), v1::UCode::OK);
+		} else {
+			auto answered = request.build(
+			    {"answer", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+			EXPECT_EQ(client->send(answered).code(), v1::UCode::OK);
+		}
+	}
+
+	for (int i = 0; i < 200 && client->pendingRequests() > 0; ++i) {
+		std::this_thread::sleep_for(10ms);
+	}
+	EXPECT_EQ(client->pendingRequests(), 0);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<std::string> reported;
+	for (const auto& batch : batches) {
+		for (const auto& expired : batch) {
+			EXPECT_EQ(expired.method.SerializeAsString(),
+			          makeUUri(METHOD_URI).SerializeAsString());
+			reported.push_back(expired.id.SerializeAsString());
+		}
+	}
+	std::vector<std::string> expected;
+	for (const auto& request : unanswered) {
+		expected.push_back(request.attributes().id().SerializeAsString());
+	}
+	std::sort(reported.begin(), reported.end());
+	std::sort(expected.begin(), expected.end());
+	EXPECT_EQ(reported, expected);
+	// Requests sent together expire together.
+	EXPECT_LE(batches.size(), 2);
+}
+
+}  // namespace
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// The zenoh runtime is created once per process, by the first session that
+// is opened, so this binary holds a single test: any other test opening a
+// session first would leave nothing for the runtime options to act on.
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+class RuntimePlacementTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	RuntimePlacementTest() { zenoh::init_logger(); }
+	~RuntimePlacementTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri() {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(0);
+	return uuri;
+}
+
+std::set<std::string> threadIds() {
+	std::set<std::string> ids;
+	for (const auto& entry :
+	     std::filesystem::directory_iterator("/proc/self/task")) {
+		ids.insert(entry.path().filename().string());
+	}
+	return ids;
+}
+
+std::string threadName(const std::string& path) {
+	std::ifstream comm(path + "/comm");
+	std::string name;
+	std::getline(comm, name);
+	return name;
+}
+
+// Reads one "Field:\tvalue" line from a thread's status file.
+std::string threadStatus(const std::string& id, const std::string& field) {
+	std::ifstream status("/proc/self/task/" + id + "/status");
+	for (std::string line; std::getline(status, line);) {
+		if (line.rfind(field + ":", 0) == 0) {
+			return line.substr(line.find_first_not_of(" \t", field.size() + 1));
+		}
+	}
+	return {};
+}
+
+TEST_F(RuntimePlacementTest, RuntimeThreadsArePlaced) {
+	// Pin the runtime to one of the CPUs this test may already use.
+	cpu_set_t before;
+	ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(before), &before),
+	          0);
+	int cpu = 0;
+	while (!CPU_ISSET(cpu, &before)) {
+		++cpu;
+	}
+
+	::unsetenv("ZENOH_RUNTIME");
+	auto own_name = threadName("/proc/thread-self");
+	auto existing = threadIds();
+
+	transport::ZenohUTransportOptions options;
+	options.runtime.rx_threads = 2;
+	options.runtime.app_threads = 1;
+	options.runtime.cpu_affinity = {cpu};
+	options.runtime.sched_policy = SCHED_BATCH;
+	transport::ZenohUTransport transport(makeUUri(), ZENOH_CONFIG_FILE,
+	                                     options);
+
+	// Only set while the sessions were opened, and not left for child
+	// processes to inherit.
+	EXPECT_EQ(std::getenv("ZENOH_RUNTIME"), nullptr);
+
+	// The runtime names its threads after their pool, so threads that kept
+	// this thread's name (e.g. the transport's own) are not runtime threads.
+	size_t runtime_threads = 0;
+	for (const auto& id : threadIds()) {
+		if (existing.count(id) != 0 ||
+		    threadName("/proc/self/task/" + id) == own_name) {
+			continue;
+		}
+		++runtime_threads;
+		EXPECT_EQ(threadStatus(id, "Cpus_allowed_list"), std::to_string(cpu))
+		    << "thread " << id;
+		EXPECT_EQ(sched_getscheduler(std::stoi(id)), SCHED_BATCH)
+		    << "thread " << id;
+	}
+	EXPECT_GT(runtime_threads, 0U);
+
+	// The constructing thread gets its own placement back.
+	cpu_set_t after;
+	ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(after), &after),
+	          0);
+	EXPECT_TRUE(CPU_EQUAL(&before, &after));
+	EXPECT_EQ(sched_getscheduler(0), SCHED_OTHER);
+}
+
+}  // namespace
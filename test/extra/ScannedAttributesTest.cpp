@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "up-transport-zenoh-cpp/ScannedAttributes.h"
+
+namespace {
+
+using namespace uprotocol;
+using transport::ScannedAttributes;
+
+constexpr size_t FUZZ_ITERATIONS = 20000;
+
+class ScannedAttributesTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	ScannedAttributesTest() = default;
+	~ScannedAttributesTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UAttributes randomAttributes(std::mt19937_64& random) {
+	auto pick = [&random](uint64_t bound) { return random() % bound; };
+
+	v1::UAttributes attributes;
+	attributes.mutable_id()->set_msb(random());
+	attributes.mutable_id()->set_lsb(random());
+	attributes.set_type(static_cast<v1::UMessageType>(pick(5)));
+	attributes.set_priority(static_cast<v1::UPriority>(pick(8)));
+	attributes.set_ttl(static_cast<uint32_t>(random()));
+	attributes.set_payload_format(static_cast<v1::UPayloadFormat>(pick(8)));
+	if (pick(2) != 0) {
+		attributes.set_permission_level(static_cast<uint32_t>(random()));
+	}
+	if (pick(2) != 0) {
+		attributes.set_commstatus(static_cast<v1::UCode>(pick(17)));
+	}
+
+	auto* source = attributes.mutable_source();
+	source->set_authority_name("host-" + std::to_string(pick(1000)));
+	source->set_ue_id(static_cast<uint32_t>(random()));
+	source->set_ue_version_major(static_cast<uint32_t>(pick(256)));
+	source->set_resource_id(static_cast<uint32_t>(pick(0x10000)));
+	if (pick(2) != 0) {
+		*attributes.mutable_sink() = *source;
+		attributes.mutable_sink()->set_resource_id(0);
+	}
+	if (pick(4) == 0) {
+		attributes.mutable_reqid()->set_msb(random());
+		attributes.mutable_reqid()->set_lsb(random());
+		attributes.set_token(std::string(pick(40), 't'));
+		attributes.set_traceparent(std::string(pick(60), 'p'));
+	}
+	return attributes;
+}
+
+void expectMatches(const v1::UAttributes& parsed,
+                   const ScannedAttributes& scanned) {
+	EXPECT_EQ(scanned.id_msb, parsed.id().msb());
+	EXPECT_EQ(scanned.id_lsb, parsed.id().lsb());
+	EXPECT_EQ(scanned.reqid_msb, parsed.reqid().msb());
+	EXPECT_EQ(scanned.reqid_lsb, parsed.reqid().lsb());
+	EXPECT_EQ(scanned.type, parsed.type());
+	EXPECT_EQ(scanned.priority, parsed.priority());
+	EXPECT_EQ(scanned.ttl, parsed.ttl());
+	EXPECT_EQ(scanned.payload_format, parsed.payload_format());
+	ASSERT_EQ(scanned.permission_level.has_value(),
+	          parsed.has_permission_level());
+	if (scanned.permission_level) {
+		EXPECT_EQ(*scanned.permission_level, parsed.permission_level());
+	}
+	ASSERT_EQ(scanned.commstatus.has_value(), parsed.has_commstatus());
+	if (scanned.commstatus) {
+		EXPECT_EQ(*scanned.commstatus, parsed.commstatus());
+	}
+}
+
+std::string mutate(std::string bytes, std::mt19937_64& random) {
+	auto pick = [&random](uint64_t bound) {
+		return static_cast<size_t>(random() % bound);
+	};
+	for (size_t mutation = pick(4) + 1; mutation > 0; --mutation) {
+		switch (pick(5)) {
+			case 0:
+				if (!bytes.empty()) {
+					bytes[pick(bytes.size())] = static_cast<char>(random());
+				}
+				break;
+			case 1:
+				if (!bytes.empty()) {
+					bytes.resize(pick(bytes.size()));
+				}
+				break;
+			case 2:
+				bytes.insert(pick(bytes.size() + 1), 1,
+				             static_cast<char>(random()));
+				break;
+			case 3:
+				if (!bytes.empty()) {
+					bytes.erase(pick(bytes.size()), 1);
+				}
+				break;
+			default: {
+				// Repeated fields: the last value wins, and messages merge.
+				size_t begin = pick(bytes.size() + 1);
+				bytes += bytes.substr(begin, pick(bytes.size() - begin + 1));
+				break;
+			}
+		}
+	}
+	return bytes;
+}
+
+TEST_F(ScannedAttributesTest, MatchesParserOnValidMessages) {
+	std::mt19937_64 random(1);
+	for (size_t i = 0; i < FUZZ_ITERATIONS; ++i) {
+		auto attributes = randomAttributes(random);
+		auto scanned = ScannedAttributes::scan(attributes.SerializeAsString());
+		ASSERT_TRUE(scanned);
+		expectMatches(attributes, *scanned);
+	}
+}
+
+TEST_F(ScannedAttributesTest, MatchesParserOnMutatedMessages) {
+	std::mt19937_64 random(2);
+	size_t accepted = 0;
+	for (size_t i = 0; i < FUZZ_ITERATIONS; ++i) {
+		auto bytes =
+		    mutate(randomAttributes(random).SerializeAsString(), random);
+		v1::UAttributes parsed;
+		if (!parsed.ParseFromString(bytes)) {
+			// Whatever scan() returns is fine, as long as it returns.
+			(void)ScannedAttributes::scan(bytes);
+			continue;
+		}
+		++accepted;
+		auto scanned = ScannedAttributes::scan(bytes);
+		ASSERT_TRUE(scanned) << testing::PrintToString(bytes);
+		expectMatches(parsed, *scanned);
+	}
+	// Enough mutations stay parseable to make the comparison meaningful.
+	EXPECT_GT(accepted, FUZZ_ITERATIONS / 20);
+}
+
+TEST_F(ScannedAttributesTest, WireFormatCornerCases) {
+	// ttl = 1, then an unknown group holding a nested group and a varint,
+	// then ttl = 2 with a non-minimal varint, then type = -1 as a ten-byte
+	// varint, then priority with the wrong wire type (fixed32).
+	constexpr char CORNER_CASES[] =
+	    "\x30\x01"
+	    "\xA3\x06\xAB\x06\x08\x05\xAC\x06\xA4\x06"
+	    "\x30\x82\x00"
+	    "\x10\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x01"
+	    "\x2D\x01\x02\x03\x04";
+	const std::string bytes(CORNER_CASES, sizeof(CORNER_CASES) - 1);
+	v1::UAttributes parsed;
+	ASSERT_TRUE(parsed.ParseFromString(bytes));
+	auto scanned = ScannedAttributes::scan(bytes);
+	ASSERT_TRUE(scanned);
+	expectMatches(parsed, *scanned);
+	EXPECT_EQ(scanned->ttl, 2);
+	EXPECT_EQ(static_cast<int>(scanned->type), -1);
+
+	// Truncated varint, overlong varint, unmatched end group, field zero,
+	// six-byte tag.
+	for (const std::string& malformed :
+	     {std::string("\x30\x80", 2),
+	      std::string("\x30\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x01", 12),
+	      std::string("\xA4\x06", 2), std::string("\x00\x01", 2),
+	      std::string("\xB0\x80\x80\x80\x80\x00\x01", 7)}) {
+		EXPECT_FALSE(parsed.ParseFromString(malformed));
+		EXPECT_FALSE(ScannedAttributes::scan(malformed));
+	}
+}
+
+}  // namespace
@@ -0,0 +1,179 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <set>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t SLOW_TOPIC = 0x8000;
+constexpr uint16_t FAST_TOPIC = 0x8001;
+
+class SlowListenerTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	SlowListenerTest() { zenoh::init_logger(); }
+	~SlowListenerTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+v1::UMessage makeMessage(uint16_t resource_id) {
+	return datamodel::builder::UMessageBuilder::publish(makeUUri(resource_id))
+	    .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+}
+
+TEST_F(SlowListenerTest, ReportsAreRateLimited) {
+	std::vector<transport::SlowListenerEvent> events;
+	transport::SlowListenerOptions options;
+	options.budget = 1ms;
+	options.report_interval = 1h;
+	options.on_slow_listener =
+	    [&events](const transport::SlowListenerEvent& event) {
+		    events.push_back(event);
+	    };
+	transport::SlowListenerDetector detector(options);
+	auto monitor = detector.monitor("key");
+
+	detector.measure(*monitor, []() {});
+	EXPECT_TRUE(events.empty());
+	for (int i = 0; i < 3; ++i) {
+		detector.measure(*monitor, []() { std::this_thread::sleep_for(2ms); });
+	}
+	ASSERT_EQ(events.size(), 1);
+	EXPECT_EQ(events[0].zenoh_key, "key");
+	EXPECT_GE(events[0].wall_time, 2ms);
+	// Sleeping does not use CPU.
+	EXPECT_LT(events[0].cpu_time, events[0].wall_time);
+	EXPECT_FALSE(events[0].isolated);
+
+	auto stats = detector.stats();
+	ASSERT_EQ(stats.size(), 1);
+	EXPECT_EQ(stats[0].invocations, 4);
+	EXPECT_EQ(stats[0].overruns, 3);
+	EXPECT_EQ(stats[0].wall_time.count(), 4);
+	EXPECT_GE(stats[0].wall_time.max(), 2ms);
+
+	monitor.reset();
+	EXPECT_TRUE(detector.stats().empty());
+}
+
+TEST_F(SlowListenerTest, IsolatesOffendersInTransport) {
+	constexpr size_t num_messages = 6;
+
+	std::mutex events_mtx;
+	std::vector<transport::SlowListenerEvent> events;
+	transport::ZenohUTransportOptions options;
+	options.slow_listeners.budget = 1ms;
+	options.slow_listeners.isolate_after = 2;
+	options.slow_listeners.on_slow_listener =
+	    [&](const transport::SlowListenerEvent& event) {
+		    std::lock_guard lock(events_mtx);
+		    events.push_back(event);
+	    };
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+
+	std::mutex threads_mtx;
+	std::vector<std::thread::id> slow_threads;
+	std::atomic<size_t> slow_received{0};
+	auto slow_handle = transport->registerListener(
+	    makeUUri(SLOW_TOPIC),
+	    [&](const v1::UMessage&) {
+		    std::this_thread::sleep_for(5ms);
+		    std::lock_guard lock(threads_mtx);
+		    slow_threads.push_back(std::this_thread::get_id());
+		    ++slow_received;
+	    },
+	    {});
+	ASSERT_TRUE(slow_handle);
+
+	std::atomic<size_t> fast_received{0};
+	auto fast_handle = transport->registerListener(
+	    makeUUri(FAST_TOPIC),
+	    [&fast_received](const v1::UMessage&) { ++fast_received; }, {});
+	ASSERT_TRUE(fast_handle);
+
+	for (size_t i = 0; i < num_messages; ++i) {
+		EXPECT_EQ(transport->send(makeMessage(SLOW_TOPIC)).code(),
+		          v1::UCode::OK);
+		EXPECT_EQ(transport->send(makeMessage(FAST_TOPIC)).code(),
+		          v1::UCode::OK);
+	}
+	for (int i = 0; i < 200 && slow_received < num_messages; ++i) {
+		std::this_thread::sleep_for(10ms);
+	}
+	ASSERT_EQ(slow_received, num_messages);
+	EXPECT_EQ(fast_received, num_messages);
+
+	{
+		std::lock_guard lock(events_mtx);
+		ASSERT_FALSE(events.empty());
+		EXPECT_TRUE(events.back().isolated);
+	}
+
+	// Once isolated, the slow listener runs on a thread of its own.
+	{
+		std::lock_guard lock(threads_mtx);
+		EXPECT_NE(slow_threads.front(), slow_threads.back());
+	}
+
+	auto stats = transport->listenerStats();
+	ASSERT_EQ(stats.size(), 2);
+	for (const auto& listener : stats) {
+		EXPECT_EQ(listener.invocations, num_messages);
+		EXPECT_EQ(listener.dropped, 0);
+		if (listener.isolated) {
+			EXPECT_EQ(listener.overruns, num_messages);
+		} else {
+			EXPECT_EQ(listener.overruns, 0);
+		}
+	}
+}
+
+TEST_F(SlowListenerTest, DisabledByDefault) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	auto handle = transport->registerListener(
+	    makeUUri(SLOW_TOPIC), [](const v1::UMessage&) {}, {});
+	ASSERT_TRUE(handle);
+	EXPECT_TRUE(transport->listenerStats().empty());
+}
+
+}  // namespace
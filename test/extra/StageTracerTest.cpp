@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+
+class StageTracerTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	StageTracerTest() { zenoh::init_logger(); }
+	~StageTracerTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+size_t countOf(const std::string& haystack, const std::string& needle) {
+	size_t count = 0;
+	for (auto pos = haystack.find(needle); pos != std::string::npos;
+	     pos = haystack.find(needle, pos + needle.size())) {
+		++count;
+	}
+	return count;
+}
+
+TEST_F(StageTracerTest, RingKeepsNewestEvents) {
+	transport::StageTracer tracer(4);
+	const char* names[] = {"e0", "e1", "e2", "e3", "e4", "e5"};
+	for (const char* name : names) {
+		auto now = transport::StageTracer::now();
+		tracer.record("test", name, now, now + 1000);
+	}
+
+	std::ostringstream trace;
+	tracer.dumpChromeTrace(trace);
+	auto json = trace.str();
+	EXPECT_EQ(countOf(json, "\"ph\":\"X\""), 4);
+	EXPECT_EQ(countOf(json, "\"name\":\"e1\""), 0);
+	EXPECT_EQ(countOf(json, "\"name\":\"e2\""), 1);
+	EXPECT_EQ(countOf(json, "\"name\":\"e5\""), 1);
+	EXPECT_EQ(countOf(json, "\"dur\":1.000"), 4);
+	EXPECT_EQ(json.front(), '{');
+	EXPECT_EQ(json.back(), '}');
+}
+
+TEST_F(StageTracerTest, DumpKeepsStreamFormatting) {
+	transport::StageTracer tracer(4);
+	auto now = transport::StageTracer::now();
+	tracer.record("test", "e0", now, now + 1500);
+
+	std::ostringstream trace;
+	trace << std::scientific << std::setprecision(2);
+	auto flags = trace.flags();
+	tracer.dumpChromeTrace(trace);
+	EXPECT_EQ(countOf(trace.str(), "\"dur\":1.500"), 1);
+	EXPECT_EQ(trace.flags(), flags);
+	EXPECT_EQ(trace.precision(), 2);
+
+	std::ostringstream value;
+	value << std::scientific << std::setprecision(2) << 1.5;
+	trace.str("");
+	trace << 1.5;
+	EXPECT_EQ(trace.str(), value.str());
+}
+
+TEST_F(StageTracerTest, DumpWhileRecording) {
+	transport::StageTracer tracer(64);
+	std::atomic<size_t> done{0};
+	std::vector<std::thread> writers;
+	for (int i = 0; i < 4; ++i) {
+		writers.emplace_back([&tracer, &done]() {
+			for (int n = 0; n < 100000; ++n) {
+				transport::StageTracer::Span span(&tracer, "test", "span");
+			}
+			++done;
+		});
+	}
+
+	while (done < writers.size()) {
+		std::ostringstream trace;
+		tracer.dumpChromeTrace(trace);
+		EXPECT_LE(countOf(trace.str(), "\"ph\":\"X\""), 4 * 64);
+	}
+	for (auto& writer : writers) {
+		writer.join();
+	}
+
+	std::ostringstream trace;
+	tracer.dumpChromeTrace(trace);
+	EXPECT_EQ(countOf(trace.str(), "\"ph\":\"X\""), 4 * 64);
+}
+
+TEST_F(StageTracerTest, TransportTracesStages) {
+	transport::ZenohUTransportOptions options;
+	options.trace_events_per_thread = 1024;
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+
+	std::atomic<size_t> received{0};
+	auto handle = transport->registerListener(
+	    makeUUri(TOPIC_URI), [&received](const v1::UMessage&) { ++received; },
+	    {});
+	ASSERT_TRUE(handle);
+
+	auto message =
+	    datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC_URI))
+	        .build({"12345", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+	EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	for (int i = 0; i < 100 && received == 0; ++i) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	ASSERT_EQ(received, 1);
+
+	std::ostringstream trace;
+	transport->dumpTrace(trace);
+	auto json = trace.str();
+	for (const char* stage :
+	     {"sendImpl", "toZenohKeyString", "sendPublishNotification_",
+	      "uattributesToAttachment", "put", "on_sample", "sampleToUMessage",
+	      "listener"}) {
+		EXPECT_EQ(countOf(json, "\"name\":\"" + std::string(stage) + "\""),
+		          1)
+		    << stage;
+	}
+}
+
+TEST_F(StageTracerTest, DisabledByDefault) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	std::ostringstream trace;
+	transport->dumpTrace(trace);
+	EXPECT_EQ(trace.str(), "{\"traceEvents\":[]}");
+}
+
+}  // namespace
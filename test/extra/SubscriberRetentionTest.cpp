@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+
+class SubscriberRetentionTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	SubscriberRetentionTest() { zenoh::init_logger(); }
+	~SubscriberRetentionTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+	for (int i = 0; i < 200 && !predicate(); ++i) {
+		std::this_thread::sleep_for(10ms);
+	}
+	return predicate();
+}
+
+TEST_F(SubscriberRetentionTest, PoolEvictsOldestAndExpires) {
+	transport::RetentionPool<std::unique_ptr<int>> pool(2, 100ms);
+	pool.park("a", std::make_unique<int>(1));
+	pool.park("b", std::make_unique<int>(2));
+	pool.park("a", std::make_unique<int>(3));
+
+	auto stats = pool.stats();
+	EXPECT_EQ(stats.evicted, 1);
+	EXPECT_EQ(stats.retained, 2);
+
+	// The first "a" was evicted, the second is still there.
+	auto a = pool.take("a");
+	ASSERT_TRUE(a);
+	EXPECT_EQ(**a, 3);
+	EXPECT_FALSE(pool.take("a"));
+
+	EXPECT_TRUE(waitFor([&pool]() { return pool.stats().retained == 0; }));
+	stats = pool.stats();
+	EXPECT_EQ(stats.hits, 1);
+	EXPECT_EQ(stats.misses, 1);
+	EXPECT_EQ(stats.expired, 1);
+	EXPECT_FALSE(pool.take("b"));
+}
+
+TEST_F(SubscriberRetentionTest, ReRegistrationReusesSubscriber) {
+	transport::ZenohUTransportOptions options;
+	options.retention.capacity = 16;
+	options.retention.grace_period = 10s;
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+	auto message =
+	    datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC_URI))
+	        .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+
+	std::atomic<size_t> first_received{0};
+	auto first = transport->registerListener(
+	    makeUUri(TOPIC_URI),
+	    [&first_received](const v1::UMessage&) { ++first_received; }, {});
+	ASSERT_TRUE(first);
+	EXPECT_EQ(transport->retentionStats().misses, 1);
+
+	// Removing the listener retains its subscriber.
+	first.value().reset();
+	EXPECT_EQ(transport->retentionStats().retained, 1);
+	EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+
+	std::atomic<size_t> second_received{0};
+	auto second = transport->registerListener(
+	    makeUUri(TOPIC_URI),
+	    [&second_received](const v1::UMessage&) { ++second_received; }, {});
+	ASSERT_TRUE(second);
+
+	auto stats = transport->retentionStats();
+	EXPECT_EQ(stats.hits, 1);
+	EXPECT_EQ(stats.retained, 0);
+
+	EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	EXPECT_TRUE(waitFor([&second_received]() { return second_received > 0; }));
+	EXPECT_EQ(second_received, 1);
+	EXPECT_EQ(first_received, 0);
+}
+
+TEST_F(SubscriberRetentionTest, IdleSubscribersExpire) {
+	transport::ZenohUTransportOptions options;
+	options.retention.capacity = 16;
+	options.retention.grace_period = 50ms;
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+
+	{
+		auto handle = transport->registerListener(
+		    makeUUri(TOPIC_URI), [](const v1::UMessage&) {}, {});
+		ASSERT_TRUE(handle);
+	}
+	EXPECT_EQ(transport->retentionStats().retained, 1);
+	EXPECT_TRUE(waitFor(
+	    [&transport]() { return transport->retentionStats().expired == 1; }));
+	EXPECT_EQ(transport->retentionStats().retained, 0);
+}
+
+TEST_F(SubscriberRetentionTest, DisabledByDefault) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	{
+		auto handle = transport->registerListener(
+		    makeUUri(TOPIC_URI), [](const v1::UMessage&) {}, {});
+		ASSERT_TRUE(handle);
+	}
+	auto stats = transport->retentionStats();
+	EXPECT_EQ(stats.retained, 0);
+	EXPECT_EQ(stats.misses, 0);
+}
+
+}  // namespace
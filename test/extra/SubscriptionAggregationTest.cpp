@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t FIRST_TOPIC = 0x8000;
+constexpr size_t THRESHOLD = 4;
+
+class SubscriptionAggregationTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	SubscriptionAggregationTest() { zenoh::init_logger(); }
+	~SubscriptionAggregationTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+v1::UMessage makeMessage(uint16_t resource_id) {
+	return datamodel::builder::UMessageBuilder::publish(makeUUri(resource_id))
+	    .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+}
+
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+	for (int i = 0; i < 200 && !predicate(); ++i) {
+		std::this_thread::sleep_for(10ms);
+	}
+	return predicate();
+}
+
+std::shared_ptr<transport::ZenohUTransport> makeTransport() {
+	transport::ZenohUTransportOptions options;
+	options.aggregation.threshold = THRESHOLD;
+	return std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+}
+
+TEST_F(SubscriptionAggregationTest, DemultiplexesByResourceId) {
+	auto transport = makeTransport();
+
+	// Crosses the threshold half way through, so both listeners registered
+	// before and after aggregation are covered.
+	constexpr size_t LISTENERS = 2 * THRESHOLD;
+	std::vector<std::atomic<size_t>> received(LISTENERS);
+	std::vector<transport::ZenohUTransport::ListenHandle> handles;
+	for (size_t i = 0; i < LISTENERS; ++i) {
+		auto handle = transport->registerListener(
+		    makeUUri(static_cast<uint16_t>(FIRST_TOPIC + i)),
+		    [&received, i](const v1::UMessage&) { ++received[i]; }, {});
+		ASSERT_TRUE(handle);
+		handles.push_back(std::move(handle).value());
+	}
+
+	for (size_t i = 0; i < LISTENERS; ++i) {
+		auto message = makeMessage(static_cast<uint16_t>(FIRST_TOPIC + i));
+		EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	}
+	// Matches the group's wildcard, but nobody listens to it.
+	EXPECT_EQ(transport
+	              ->send(makeMessage(
+	                  static_cast<uint16_t>(FIRST_TOPIC + LISTENERS)))
+	              .code(),
+	          v1::UCode::OK);
+
+	for (size_t i = 0; i < LISTENERS; ++i) {
+		EXPECT_TRUE(waitFor([&received, i]() { return received[i] > 0; }));
+	}
+	std::this_thread::sleep_for(50ms);
+	for (size_t i = 0; i < LISTENERS; ++i) {
+		EXPECT_EQ(received[i], 1) << "listener " << i;
+	}
+}
+
+TEST_F(SubscriptionAggregationTest, RemovedListenersStopReceiving) {
+	auto transport = makeTransport();
+
+	std::vector<std::atomic<size_t>> received(THRESHOLD);
+	std::vector<transport::ZenohUTransport::ListenHandle> handles;
+	for (size_t i = 0; i < THRESHOLD; ++i) {
+		auto handle = transport->registerListener(
+		    makeUUri(FIRST_TOPIC),
+		    [&received, i](const v1::UMessage&) { ++received[i]; }, {});
+		ASSERT_TRUE(handle);
+		handles.push_back(std::move(handle).value());
+	}
+
+	handles[0].reset();
+	EXPECT_EQ(transport->send(makeMessage(FIRST_TOPIC)).code(), v1::UCode::OK);
+	EXPECT_TRUE(waitFor([&received]() { return received[1] > 0; }));
+	EXPECT_EQ(received[0], 0);
+	EXPECT_EQ(received[1], 1);
+
+	// Removing the last member undeclares the group. A new listener starts
+	// over with a subscriber of its own.
+	handles.clear();
+	std::atomic<size_t> late_received{0};
+	auto late = transport->registerListener(
+	    makeUUri(FIRST_TOPIC),
+	    [&late_received](const v1::UMessage&) { ++late_received; }, {});
+	ASSERT_TRUE(late);
+	EXPECT_EQ(transport->send(makeMessage(FIRST_TOPIC)).code(), v1::UCode::OK);
+	EXPECT_TRUE(waitFor([&late_received]() { return late_received > 0; }));
+	std::this_thread::sleep_for(50ms);
+	EXPECT_EQ(late_received, 1);
+	EXPECT_EQ(received[1], 1);
+}
+
+TEST_F(SubscriptionAggregationTest, HandoverLosesAndDuplicatesNothing) {
+	auto transport = makeTransport();
+
+	using Id = std::pair<uint64_t, uint64_t>;
+	std::mutex mutex;
+	std::vector<std::multiset<Id>> received(THRESHOLD);
+	std::vector<transport::ZenohUTransport::ListenHandle> handles;
+	auto listen = [&transport, &mutex, &received, &handles](size_t i) {
+		auto handle = transport->registerListener(
+		    makeUUri(static_cast<uint16_t>(FIRST_TOPIC + i)),
+		    [&mutex, &received, i](const v1::UMessage& message) {
+			    std::lock_guard<std::mutex> lock(mutex);
+			    received[i].emplace(message.attributes().id().msb(),
+			                        message.attributes().id().lsb());
+		    },
+		    {});
+		ASSERT_TRUE(handle);
+		handles.push_back(std::move(handle).value());
+	};
+	for (size_t i = 0; i + 1 < THRESHOLD; ++i) {
+		listen(i);
+	}
+
+	// The last listener crosses the threshold while messages are sent to
+	// the others, which keep coming until the handover is over.
+	constexpr size_t ROUNDS = 100;
+	std::vector<std::vector<Id>> sent(THRESHOLD - 1);
+	std::atomic<size_t> rounds{0};
+	std::atomic<bool> stop{false};
+	std::thread sender([&transport, &sent, &rounds, &stop]() {
+		while (!stop) {
+			for (size_t i = 0; i < sent.size(); ++i) {
+				auto message =
+				    makeMessage(static_cast<uint16_t>(FIRST_TOPIC + i));
+				sent[i].emplace_back(message.attributes().id().msb(),
+				                     message.attributes().id().lsb());
+				EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+			}
+			++rounds;
+		}
+	});
+	EXPECT_TRUE(waitFor([&rounds]() { return rounds >= ROUNDS; }));
+	listen(THRESHOLD - 1);
+	size_t handover_round = rounds;
+	EXPECT_TRUE(waitFor([&rounds, handover_round]() {
+		return rounds >= handover_round + ROUNDS;
+	}));
+	stop = true;
+	sender.join();
+
+	auto all_received = [&mutex, &received, &sent]() {
+		std::lock_guard<std::mutex> lock(mutex);
+		for (size_t i = 0; i < sent.size(); ++i) {
+			if (received[i].size() < sent[i].size()) {
+				return false;
+			}
+		}
+		return true;
+	};
+	EXPECT_TRUE(waitFor(all_received));
+	std::this_thread::sleep_for(50ms);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for (size_t i = 0; i < sent.size(); ++i) {
+		EXPECT_EQ(received[i].size(), sent[i].size()) << "listener " << i;
+		for (const auto& id : sent[i]) {
+			EXPECT_EQ(received[i].count(id), 1) << "listener " << i;
+		}
+	}
+}
+
+}  // namespace
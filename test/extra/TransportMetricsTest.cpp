@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+
+class TransportMetricsTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	TransportMetricsTest() { zenoh::init_logger(); }
+	~TransportMetricsTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+TEST_F(TransportMetricsTest, SnapshotSumsThreads) {
+	constexpr size_t num_threads = 8;
+	constexpr uint64_t per_thread = 1000;
+	transport::TransportMetrics metrics;
+
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < num_threads; ++i) {
+		threads.emplace_back([&metrics]() {
+			for (uint64_t n = 0; n < per_thread; ++n) {
+				auto& counters = metrics.local("a");
+				transport::TransportMetrics::add(counters.messages_sent, 1);
+				transport::TransportMetrics::add(counters.bytes_sent, 10);
+			}
+			auto& other = metrics.local("b");
+			transport::TransportMetrics::add(other.decode_failures, 1);
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	// Counts survive the threads that made them.
+	auto snapshot = metrics.snapshot();
+	ASSERT_EQ(snapshot.size(), 2);
+	EXPECT_EQ(snapshot["a"].messages_sent, num_threads * per_thread);
+	EXPECT_EQ(snapshot["a"].bytes_sent, num_threads * per_thread * 10);
+	EXPECT_EQ(snapshot["b"].decode_failures, num_threads);
+	EXPECT_EQ(snapshot["b"].messages_sent, 0);
+}
+
+TEST_F(TransportMetricsTest, InstancesAreIndependent) {
+	auto first = std::make_unique<transport::TransportMetrics>();
+	transport::TransportMetrics::add(first->local("a").messages_sent, 1);
+	first.reset();
+
+	transport::TransportMetrics second;
+	transport::TransportMetrics::add(second.local("a").messages_sent, 2);
+	EXPECT_EQ(second.snapshot()["a"].messages_sent, 2);
+}
+
+TEST_F(TransportMetricsTest, TransportCountsSendAndReceive) {
+	constexpr size_t num_messages = 10;
+	transport::ZenohUTransportOptions options;
+	options.metrics = true;
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+
+	std::atomic<size_t> received{0};
+	auto handle = transport->registerListener(
+	    makeUUri(TOPIC_URI),
+	    [&received](const v1::UMessage&) {
+		    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		    ++received;
+	    },
+	    {});
+	ASSERT_TRUE(handle);
+
+	for (size_t i = 0; i < num_messages; ++i) {
+		auto message =
+		    datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC_URI))
+		        .build({"12345", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	}
+	for (int i = 0; i < 100 && received < num_messages; ++i) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	ASSERT_EQ(received, num_messages);
+
+	auto snapshot = transport->metricsSnapshot();
+	ASSERT_EQ(snapshot.size(), 1);
+	const auto& topic = snapshot.begin()->second;
+	EXPECT_EQ(topic.messages_sent, num_messages);
+	EXPECT_EQ(topic.bytes_sent, num_messages * 5);
+	EXPECT_EQ(topic.send_failures, 0);
+	EXPECT_EQ(topic.messages_received, num_messages);
+	EXPECT_EQ(topic.bytes_received, num_messages * 5);
+	EXPECT_EQ(topic.decode_failures, 0);
+	EXPECT_EQ(topic.listener_invocations, num_messages);
+	EXPECT_GE(topic.listener_time,
+	          std::chrono::milliseconds(1) * num_messages);
+}
+
+TEST_F(TransportMetricsTest, HistogramBucketsAreTight) {
+	using std::chrono::microseconds;
+	for (int64_t value : {0, 1, 31, 32, 33, 100, 1000, 123456, 99999999}) {
+		auto bucket =
+		    transport::LatencyHistogram::bucketFor(microseconds(value));
+		auto upper = transport::LatencyHistogram::bucketUpperBound(bucket);
+		EXPECT_GE(upper.count(), value);
+		EXPECT_LE(static_cast<double>(upper.count()),
+		          static_cast<double>(value) * 1.04 + 1);
+	}
+	EXPECT_EQ(transport::LatencyHistogram::bucketFor(microseconds(-5)), 0);
+	EXPECT_EQ(transport::LatencyHistogram::bucketFor(microseconds::max()),
+	          transport::LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST_F(TransportMetricsTest, HistogramPercentiles) {
+	transport::LatencyHistogram histogram;
+	EXPECT_EQ(histogram.percentile(0.99).count(), 0);
+
+	for (int64_t value = 1; value <= 1000; ++value) {
+		histogram.record(std::chrono::microseconds(value));
+	}
+	EXPECT_EQ(histogram.count(), 1000);
+	// Reported values are bucket upper bounds, at most ~3% above.
+	EXPECT_GE(histogram.percentile(0.5).count(), 500);
+	EXPECT_LE(histogram.percentile(0.5).count(), 515);
+	EXPECT_GE(histogram.percentile(0.99).count(), 990);
+	EXPECT_LE(histogram.percentile(0.99).count(), 1020);
+	EXPECT_GE(histogram.max().count(), 1000);
+	EXPECT_LE(histogram.max().count(), 1031);
+
+	transport::LatencyHistogram other;
+	other.record(std::chrono::seconds(10));
+	histogram.merge(other);
+	EXPECT_EQ(histogram.count(), 1001);
+	EXPECT_GE(histogram.max(), std::chrono::seconds(10));
+}
+
+TEST_F(TransportMetricsTest, TransportTracksDeliveryLatency) {
+	constexpr size_t num_messages = 10;
+	transport::ZenohUTransportOptions options;
+	options.latency_tracking = true;
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+
+	std::atomic<size_t> received{0};
+	auto handle = transport->registerListener(
+	    makeUUri(TOPIC_URI), [&received](const v1::UMessage&) { ++received; },
+	    {});
+	ASSERT_TRUE(handle);
+
+	for (size_t i = 0; i < num_messages; ++i) {
+		auto message =
+		    datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC_URI))
+		        .build({"12345", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+		EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	}
+	for (int i = 0; i < 100 && received < num_messages; ++i) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	ASSERT_EQ(received, num_messages);
+
+	auto snapshot = transport->metricsSnapshot();
+	ASSERT_EQ(snapshot.size(), 1);
+	const auto& latency = snapshot.begin()->second.delivery_latency;
+	EXPECT_EQ(latency.count(), num_messages);
+	// Sender and receiver share a clock here, so only delivery counts.
+	EXPECT_LT(latency.percentile(0.99), std::chrono::seconds(1));
+}
+
+TEST_F(TransportMetricsTest, DisabledByDefault) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+	auto message =
+	    datamodel::builder::UMessageBuilder::publish(makeUUri(TOPIC_URI))
+	        .build({"12345", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+	EXPECT_EQ(transport->send(message).code(), v1::UCode::OK);
+	EXPECT_TRUE(transport->metricsSnapshot().empty());
+}
+
+}  // namespace
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2024 Contributors to the Eclipse Foundation
+//
+// See the NOTICE file(s) distributed with this work for additional
+// information regarding copyright ownership.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache License Version 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <up-cpp/datamodel/builder/UMessage.h>
+
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "up-transport-zenoh-cpp/ZenohUTransport.h"
+
+namespace {
+
+using namespace uprotocol;
+using namespace std::chrono_literals;
+using datamodel::builder::UMessageBuilder;
+
+constexpr std::string_view ZENOH_CONFIG_FILE = BUILD_REALPATH_ZENOH_CONF;
+
+constexpr uint16_t TOPIC_URI = 0x8000;
+
+class TtlEnforcementTest : public testing::Test {
+protected:
+	// Run once per TEST_F.
+	// Used to set up clean environments per test.
+	void SetUp() override {}
+	void TearDown() override {}
+
+	// Run once per execution of the test application.
+	// Used for setup of all tests. Has access to this instance.
+	TtlEnforcementTest() { zenoh::init_logger(); }
+	~TtlEnforcementTest() = default;
+
+	// Run once per execution of the test application.
+	// Used only for global setup outside of tests.
+	static void SetUpTestSuite() {}
+	static void TearDownTestSuite() {}
+};
+
+v1::UUri makeUUri(uint16_t resource_id) {
+	v1::UUri uuri;
+	uuri.set_authority_name(static_cast<std::string>("test0"));
+	uuri.set_ue_id(0x10001);
+	uuri.set_ue_version_major(1);
+	uuri.set_resource_id(resource_id);
+	return uuri;
+}
+
+v1::UMessage makeMessage(std::chrono::milliseconds ttl) {
+	return UMessageBuilder::publish(makeUUri(TOPIC_URI))
+	    .withTtl(ttl)
+	    .build({"data", v1::UPayloadFormat::UPAYLOAD_FORMAT_TEXT});
+}
+
+transport::ZenohUTransportOptions enforcing() {
+	transport::ZenohUTransportOptions options;
+	options.metrics = true;
+	options.ttl_enforcement.enabled = true;
+	options.ttl_enforcement.clock_skew_tolerance = 0ms;
+	return options;
+}
+
+TEST_F(TtlEnforcementTest, RejectsExpiredSends) {
+	auto transport = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, enforcing());
+
+	auto expired = makeMessage(1ms);
+	std::this_thread::sleep_for(20ms);
+	EXPECT_EQ(transport->send(expired).code(),
+	          v1::UCode::DEADLINE_EXCEEDED);
+	EXPECT_EQ(transport->send(makeMessage(60s)).code(), v1::UCode::OK);
+	// Messages without a TTL never expire.
+	EXPECT_EQ(transport->send(makeMessage(0ms)).code(), v1::UCode::OK);
+
+	auto snapshot = transport->metricsSnapshot();
+	ASSERT_EQ(snapshot.size(), 1);
+	EXPECT_EQ(snapshot.begin()->second.expired_sends, 1);
+	EXPECT_EQ(snapshot.begin()->second.messages_sent, 2);
+}
+
+TEST_F(TtlEnforcementTest, DropsExpiredReceives) {
+	auto receiver = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, enforcing());
+	// Does not enforce TTLs, so it sends expired messages.
+	auto sender = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	std::mutex mutex;
+	std::vector<uint32_t> received;
+	auto handle = receiver->registerListener(
+	    makeUUri(TOPIC_URI),
+	    [&mutex, &received](const v1::UMessage& message) {
+		    std::lock_guard<std::mutex> lock(mutex);
+		    received.push_back(message.attributes().ttl());
+	    },
+	    {});
+	ASSERT_TRUE(handle);
+
+	auto expired = makeMessage(1ms);
+	std::this_thread::sleep_for(20ms);
+	EXPECT_EQ(sender->send(expired).code(), v1::UCode::OK);
+	EXPECT_EQ(sender->send(makeMessage(60s)).code(), v1::UCode::OK);
+
+	for (int i = 0; i < 200; ++i) {
+		auto snapshot = receiver->metricsSnapshot();
+		if (!snapshot.empty() &&
+		    snapshot.begin()->second.messages_received == 2) {
+			break;
+		}
+		std::this_thread::sleep_for(10ms);
+	}
+	auto snapshot = receiver->metricsSnapshot();
+	ASSERT_EQ(snapshot.size(), 1);
+	EXPECT_EQ(snapshot.begin()->second.messages_received, 2);
+	EXPECT_EQ(snapshot.begin()->second.expired_receives, 1);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	EXPECT_EQ(received, std::vector<uint32_t>{60000});
+}
+
+TEST_F(TtlEnforcementTest, PullListenersDropExpiredReceives) {
+	auto options = enforcing();
+	options.trace_events_per_thread = 64;
+	auto receiver = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE, options);
+	auto sender = std::make_shared<transport::ZenohUTransport>(
+	    makeUUri(0), ZENOH_CONFIG_FILE);
+
+	auto pull = receiver->registerPullListener(makeUUri(TOPIC_URI));
+	ASSERT_TRUE(pull);
+
+	auto expired = makeMessage(1ms);
+	std::this_thread::sleep_for(20ms);
+	EXPECT_EQ(sender->send(expired).code(), v1::UCode::OK);
+	EXPECT_EQ(sender->send(makeMessage(60s)).code(), v1::UCode::OK);
+
+	std::vector<v1::UMessage> received;
+	EXPECT_EQ(pull->recvMany(received, 8, 1s), 1);
+	ASSERT_EQ(received.size(), 1);
+	EXPECT_EQ(received[0].attributes().ttl(), 60000);
+	std::this_thread::sleep_for(20ms);
+	EXPECT_EQ(pull->tryRecv(), std::nullopt);
+
+	auto snapshot = receiver->metricsSnapshot();
+	ASSERT_EQ(snapshot.size(), 1);
+	EXPECT_EQ(snapshot.begin()->second.messages_received, 2);
+	EXPECT_EQ(snapshot.begin()->second.expired_receives, 1);
+
+	std::ostringstream trace;
+	receiver->dumpTrace(trace);
+	EXPECT_NE(trace.str().find("on_sample"), std::string::npos);
+}
+
+}  // namespace